@@ -4,6 +4,7 @@
 #include <cstddef>
 #include <optional>
 #include <string>
+#include <vector>
 
 namespace midas_file_unpacker_app {
 
@@ -12,7 +13,12 @@ class ProfileRegistry;
 struct CLIOptions {
     std::string inputFile;
     std::optional<std::size_t> maxEvents;
-    std::string profileKey;
+    std::vector<std::string> profileKeys;
+    std::vector<std::string> outputsConfigs;
+    std::string cacheDir;
+    std::size_t cacheMaxGiB = 50;
+    bool trackAllocations = false;
+    bool stageTiming = false;
     bool showHelp = false;
 };
 
@@ -0,0 +1,102 @@
+#ifndef MIDAS_FILE_UNPACKER_APP_PROFILESESSION_H
+#define MIDAS_FILE_UNPACKER_APP_PROFILESESSION_H
+
+#include "midas_file_unpacker_app/diagnostics/StageTimer.h"
+#include "midas_file_unpacker_app/outputs/OutputSinkConfig.h"
+#include "midas_file_unpacker_app/profiles/EventSummary.h"
+
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+class ConfigManager;
+class Pipeline;
+class TMEvent;
+
+namespace midas_file_unpacker_app {
+
+class BatchQueue;
+class EventBatch;
+class OutputFileRegistry;
+class OutputSink;
+class PipelineProfile;
+
+/// One profile's pipeline and output sinks, fed from the shared stream of MIDAS events.
+///
+/// Several sessions can run over the same batches: each either processes them inline
+/// (processBatch) or on its own worker thread (start/submit/finish). Events must have
+/// had FindAllBanks() called before they are shared, so no session mutates them.
+class ProfileSession {
+public:
+    ProfileSession(std::shared_ptr<PipelineProfile> profile,
+                   std::filesystem::path pipeline_config_path,
+                   std::filesystem::path logger_config_path,
+                   std::filesystem::path outputs_config_path,
+                   std::vector<OutputSinkConfig> sink_configs);
+    ~ProfileSession();
+
+    ProfileSession(const ProfileSession&) = delete;
+    ProfileSession& operator=(const ProfileSession&) = delete;
+
+    PipelineProfile& profile() const { return *profile_; }
+    const std::filesystem::path& pipelineConfigPath() const { return pipeline_config_path_; }
+    const std::filesystem::path& outputsConfigPath() const { return outputs_config_path_; }
+    const std::vector<OutputSinkConfig>& sinkConfigs() const { return sink_configs_; }
+    const std::vector<std::unique_ptr<OutputSink>>& sinks() const { return sinks_; }
+    /// Logger and pipeline configs, in the order ConfigManager loads them.
+    std::vector<std::string> configFiles() const;
+
+    void buildPipeline();
+    void openOutputs(OutputFileRegistry& files);
+    void closeOutputs();
+
+    /// Decodes every event in the batch; sinks are filled only once outputs are open.
+    void processBatch(const EventBatch& batch);
+    std::size_t eventsProcessed() const { return events_processed_.load(std::memory_order_relaxed); }
+
+    /// Times input, execute, extract, fill and clear for every event from now on.
+    void enableStageTiming() { stage_times_.emplace(); }
+    /// Accumulated step times; only valid once the session has finished.
+    const std::optional<StageTimes>& stageTimes() const { return stage_times_; }
+
+    /// Runs processBatch() on a worker thread for every submitted batch.
+    void start(std::size_t queue_capacity);
+    void submit(std::shared_ptr<const EventBatch> batch);
+    /// True once the worker has hit an error; it keeps draining but stops decoding.
+    bool failed() const { return failed_.load(std::memory_order_relaxed); }
+    /// Drains the queue and joins the worker; returns the first error it hit, if any.
+    std::exception_ptr finish();
+
+private:
+    void processEvent(const std::shared_ptr<TMEvent>& event);
+    void workerLoop();
+
+    std::shared_ptr<PipelineProfile> profile_;
+    std::filesystem::path pipeline_config_path_;
+    std::filesystem::path logger_config_path_;
+    std::filesystem::path outputs_config_path_;
+    std::vector<OutputSinkConfig> sink_configs_;
+    std::vector<std::unique_ptr<OutputSink>> sinks_;
+
+    std::shared_ptr<ConfigManager> config_manager_;
+    std::unique_ptr<Pipeline> pipeline_;
+    EventSummary summary_;
+    bool outputs_open_ = false;
+    std::atomic<std::size_t> events_processed_{0};
+    std::optional<StageTimes> stage_times_;
+
+    std::unique_ptr<BatchQueue> queue_;
+    std::thread worker_;
+    std::exception_ptr worker_error_;
+    std::atomic<bool> failed_{false};
+};
+
+} // namespace midas_file_unpacker_app
+
+#endif // MIDAS_FILE_UNPACKER_APP_PROFILESESSION_H
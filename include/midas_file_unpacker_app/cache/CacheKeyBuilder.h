@@ -0,0 +1,29 @@
+#ifndef MIDAS_FILE_UNPACKER_APP_CACHE_CACHEKEYBUILDER_H
+#define MIDAS_FILE_UNPACKER_APP_CACHE_CACHEKEYBUILDER_H
+
+#include <filesystem>
+#include <string>
+#include <string_view>
+
+namespace midas_file_unpacker_app {
+
+/// Accumulates everything that determines the unpacked outputs into one hex digest.
+class CacheKeyBuilder {
+public:
+    CacheKeyBuilder& addString(std::string_view label, std::string_view value);
+    /// Full contents; used for the (small) JSON configs.
+    CacheKeyBuilder& addFileContents(const std::filesystem::path& path);
+    /// Size and modification time; used for plugin libraries and the executable.
+    CacheKeyBuilder& addFileStamp(const std::filesystem::path& path);
+    /// Size plus the first and last MiB, so copies of a run map to the same key.
+    CacheKeyBuilder& addInputIdentity(const std::filesystem::path& path);
+
+    std::string finish() const;
+
+private:
+    std::string material_;
+};
+
+} // namespace midas_file_unpacker_app
+
+#endif // MIDAS_FILE_UNPACKER_APP_CACHE_CACHEKEYBUILDER_H
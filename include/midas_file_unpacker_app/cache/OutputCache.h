@@ -0,0 +1,40 @@
+#ifndef MIDAS_FILE_UNPACKER_APP_CACHE_OUTPUTCACHE_H
+#define MIDAS_FILE_UNPACKER_APP_CACHE_OUTPUTCACHE_H
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace midas_file_unpacker_app {
+
+/// Content-addressed store of finished output files, bounded in size with LRU eviction.
+///
+/// Entries live in <directory>/<key>/ and are published with a single rename, so readers
+/// never see a half-written entry. Outputs are copied in and out, so editing a restored
+/// file can never change the cached copy.
+class OutputCache {
+public:
+    OutputCache(std::filesystem::path directory, std::uintmax_t max_bytes);
+
+    const std::filesystem::path& directory() const { return directory_; }
+
+    /// Restores every output of `key` to its original path; false on miss. An entry that
+    /// fails validation is removed so the next store() can replace it.
+    bool restore(const std::string& key, const std::vector<std::string>& outputs) const;
+    /// Stores freshly written outputs under `key`; failures only cost a later miss.
+    bool store(const std::string& key, const std::vector<std::string>& outputs) const;
+    /// Removes least recently used entries (never `keep_key`) until under the size limit.
+    std::uintmax_t evict(const std::string& keep_key) const;
+
+private:
+    std::filesystem::path entryPath(const std::string& key) const;
+    void discard(const std::string& key) const;
+
+    std::filesystem::path directory_;
+    std::uintmax_t max_bytes_;
+};
+
+} // namespace midas_file_unpacker_app
+
+#endif // MIDAS_FILE_UNPACKER_APP_CACHE_OUTPUTCACHE_H
@@ -0,0 +1,90 @@
+#ifndef MIDAS_FILE_UNPACKER_APP_DIAGNOSTICS_ALLOCATIONTRACKER_H
+#define MIDAS_FILE_UNPACKER_APP_DIAGNOSTICS_ALLOCATIONTRACKER_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+namespace midas_file_unpacker_app {
+
+/// Coarse phases of a run that heap allocations are attributed to.
+enum class RunPhase : std::uint8_t {
+    Setup,
+    Count,
+    Read,
+    Input,
+    Pipeline,
+    Extract,
+    Fill,
+    Clear,
+    Write,
+    NumPhases
+};
+
+constexpr std::size_t kNumRunPhases = static_cast<std::size_t>(RunPhase::NumPhases);
+
+const char* runPhaseName(RunPhase phase);
+
+struct PhaseAllocationStats {
+    std::uint64_t allocations = 0;
+    std::uint64_t allocated_bytes = 0;
+    /// Frees of blocks allocated in this phase, whichever phase released them.
+    std::uint64_t frees = 0;
+    std::uint64_t freed_bytes = 0;
+    /// Bytes allocated in this phase and not yet freed, and the highest value that reached.
+    std::int64_t live_bytes = 0;
+    std::int64_t peak_live_bytes = 0;
+};
+
+/// Counts every global operator new/delete once enabled.
+///
+/// The replacement operators are always linked in. Every block carries a 16-byte header
+/// recording the phase that allocated it; while disabled a call otherwise costs one relaxed
+/// atomic load. The phase is process-wide rather than per-thread so that TBB workers
+/// allocating inside pipeline.execute() are charged to the Pipeline phase. Helper threads
+/// that work for a specific phase (e.g. input prefetch) pin it with ScopedThreadRunPhase.
+class AllocationTracker {
+public:
+    static void enable();
+    static bool enabled();
+
+    static RunPhase setPhase(RunPhase phase);
+    /// Overrides the process-wide phase on the calling thread; nullopt clears the override.
+    static std::optional<RunPhase> setThreadPhase(std::optional<RunPhase> phase);
+    static std::array<PhaseAllocationStats, kNumRunPhases> snapshot();
+    static std::int64_t liveBytes();
+    static std::int64_t peakLiveBytes();
+};
+
+/// Switches the current phase for the lifetime of the scope.
+class ScopedRunPhase {
+public:
+    explicit ScopedRunPhase(RunPhase phase)
+        : previous_(AllocationTracker::setPhase(phase)) {}
+    ~ScopedRunPhase() { AllocationTracker::setPhase(previous_); }
+
+    ScopedRunPhase(const ScopedRunPhase&) = delete;
+    ScopedRunPhase& operator=(const ScopedRunPhase&) = delete;
+
+private:
+    RunPhase previous_;
+};
+
+/// Charges the calling thread's allocations to `phase`, whatever the process-wide phase is.
+class ScopedThreadRunPhase {
+public:
+    explicit ScopedThreadRunPhase(RunPhase phase)
+        : previous_(AllocationTracker::setThreadPhase(phase)) {}
+    ~ScopedThreadRunPhase() { AllocationTracker::setThreadPhase(previous_); }
+
+    ScopedThreadRunPhase(const ScopedThreadRunPhase&) = delete;
+    ScopedThreadRunPhase& operator=(const ScopedThreadRunPhase&) = delete;
+
+private:
+    std::optional<RunPhase> previous_;
+};
+
+} // namespace midas_file_unpacker_app
+
+#endif // MIDAS_FILE_UNPACKER_APP_DIAGNOSTICS_ALLOCATIONTRACKER_H
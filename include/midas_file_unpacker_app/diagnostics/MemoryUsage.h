@@ -0,0 +1,15 @@
+#ifndef MIDAS_FILE_UNPACKER_APP_DIAGNOSTICS_MEMORYUSAGE_H
+#define MIDAS_FILE_UNPACKER_APP_DIAGNOSTICS_MEMORYUSAGE_H
+
+#include <cstddef>
+
+namespace midas_file_unpacker_app {
+
+/// Resident set size right now, from /proc/self/statm (0 if unavailable).
+std::size_t currentRssBytes();
+/// Process high-water RSS from getrusage().
+std::size_t peakRssBytes();
+
+} // namespace midas_file_unpacker_app
+
+#endif // MIDAS_FILE_UNPACKER_APP_DIAGNOSTICS_MEMORYUSAGE_H
@@ -0,0 +1,50 @@
+#ifndef MIDAS_FILE_UNPACKER_APP_DIAGNOSTICS_STAGETIMER_H
+#define MIDAS_FILE_UNPACKER_APP_DIAGNOSTICS_STAGETIMER_H
+
+#include "midas_file_unpacker_app/diagnostics/AllocationTracker.h"
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+
+namespace midas_file_unpacker_app {
+
+/// Wall time one decoding thread spent in each per-event phase.
+struct StageTimes {
+    std::array<std::chrono::steady_clock::duration, kNumRunPhases> phases{};
+
+    std::chrono::steady_clock::duration& operator[](RunPhase phase) {
+        return phases[static_cast<std::size_t>(phase)];
+    }
+    std::chrono::steady_clock::duration operator[](RunPhase phase) const {
+        return phases[static_cast<std::size_t>(phase)];
+    }
+};
+
+/// Adds the scope's wall time to `phase` in `times`; does nothing when `times` is null.
+class ScopedStageTimer {
+public:
+    ScopedStageTimer(StageTimes* times, RunPhase phase)
+        : times_(times), phase_(phase) {
+        if (times_) {
+            start_ = std::chrono::steady_clock::now();
+        }
+    }
+    ~ScopedStageTimer() {
+        if (times_) {
+            (*times_)[phase_] += std::chrono::steady_clock::now() - start_;
+        }
+    }
+
+    ScopedStageTimer(const ScopedStageTimer&) = delete;
+    ScopedStageTimer& operator=(const ScopedStageTimer&) = delete;
+
+private:
+    StageTimes* times_;
+    RunPhase phase_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+} // namespace midas_file_unpacker_app
+
+#endif // MIDAS_FILE_UNPACKER_APP_DIAGNOSTICS_STAGETIMER_H
@@ -0,0 +1,38 @@
+#ifndef MIDAS_FILE_UNPACKER_APP_IO_BATCHQUEUE_H
+#define MIDAS_FILE_UNPACKER_APP_IO_BATCHQUEUE_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+
+namespace midas_file_unpacker_app {
+
+class EventBatch;
+
+/// Bounded hand-off of read batches from the reader thread to one profile's worker.
+///
+/// push() blocks while `capacity` batches are pending, so a slow profile throttles the
+/// reader instead of letting decoded input pile up in memory.
+class BatchQueue {
+public:
+    explicit BatchQueue(std::size_t capacity);
+
+    void push(std::shared_ptr<const EventBatch> batch);
+    /// Blocks until a batch is available; returns nullptr once closed and drained.
+    std::shared_ptr<const EventBatch> pop();
+    void close();
+
+private:
+    std::size_t capacity_;
+    bool closed_ = false;
+    std::deque<std::shared_ptr<const EventBatch>> batches_;
+    std::mutex mutex_;
+    std::condition_variable not_empty_;
+    std::condition_variable not_full_;
+};
+
+} // namespace midas_file_unpacker_app
+
+#endif // MIDAS_FILE_UNPACKER_APP_IO_BATCHQUEUE_H
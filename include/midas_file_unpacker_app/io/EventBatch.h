@@ -0,0 +1,38 @@
+#ifndef MIDAS_FILE_UNPACKER_APP_IO_EVENTBATCH_H
+#define MIDAS_FILE_UNPACKER_APP_IO_EVENTBATCH_H
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+class TMEvent;
+class TMReaderInterface;
+
+namespace midas_file_unpacker_app {
+
+/// Up to `capacity` MIDAS events read back-to-back and handed on as one unit.
+class EventBatch {
+public:
+    using Events = std::vector<std::shared_ptr<TMEvent>>;
+
+    explicit EventBatch(std::size_t capacity);
+
+    std::size_t capacity() const { return capacity_; }
+    std::size_t size() const { return events_.size(); }
+    bool empty() const { return events_.empty(); }
+
+    /// Replaces the contents with up to min(capacity, limit) events; 0 means end of input.
+    std::size_t read(TMReaderInterface& reader, std::size_t limit);
+    void clear() { events_.clear(); }
+
+    Events::const_iterator begin() const { return events_.begin(); }
+    Events::const_iterator end() const { return events_.end(); }
+
+private:
+    std::size_t capacity_;
+    Events events_;
+};
+
+} // namespace midas_file_unpacker_app
+
+#endif // MIDAS_FILE_UNPACKER_APP_IO_EVENTBATCH_H
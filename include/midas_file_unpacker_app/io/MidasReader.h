@@ -0,0 +1,27 @@
+#ifndef MIDAS_FILE_UNPACKER_APP_IO_MIDASREADER_H
+#define MIDAS_FILE_UNPACKER_APP_IO_MIDASREADER_H
+
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <optional>
+
+class TMReaderInterface;
+
+namespace midas_file_unpacker_app {
+
+struct ReaderDeleter {
+    void operator()(TMReaderInterface* reader) const;
+};
+
+using ReaderPtr = std::unique_ptr<TMReaderInterface, ReaderDeleter>;
+
+/// Seekable containers get a SeekableMidasReader; everything else goes through TMNewReader.
+ReaderPtr openMidasReader(const std::filesystem::path& path);
+
+/// Event count from a seekable container's index, without decompressing anything.
+std::optional<std::size_t> indexedEventCount(const std::filesystem::path& path);
+
+} // namespace midas_file_unpacker_app
+
+#endif // MIDAS_FILE_UNPACKER_APP_IO_MIDASREADER_H
@@ -0,0 +1,45 @@
+#ifndef MIDAS_FILE_UNPACKER_APP_IO_SEEKABLEMIDASFILE_H
+#define MIDAS_FILE_UNPACKER_APP_IO_SEEKABLEMIDASFILE_H
+
+#include "midas_file_unpacker_app/io/SeekableMidasFormat.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+namespace midas_file_unpacker_app {
+
+/// Read-only view of a seekable MIDAS container; readFrame() is safe to call concurrently.
+class SeekableMidasFile {
+public:
+    static bool isSeekable(const std::filesystem::path& path);
+
+    explicit SeekableMidasFile(const std::filesystem::path& path);
+    ~SeekableMidasFile();
+
+    SeekableMidasFile(const SeekableMidasFile&) = delete;
+    SeekableMidasFile& operator=(const SeekableMidasFile&) = delete;
+
+    const std::filesystem::path& path() const { return path_; }
+    const std::vector<SeekableFrameIndexEntry>& frames() const { return frames_; }
+    std::uint64_t eventCount() const { return footer_.event_count; }
+    std::uint64_t rawBytes() const { return footer_.raw_bytes; }
+
+    /// Decompressed bytes of one frame: complete MIDAS events, back to back.
+    std::vector<char> readFrame(std::size_t index) const;
+
+private:
+    void validateIndex() const;
+    void readAt(void* buffer, std::size_t size, std::uint64_t offset) const;
+
+    std::filesystem::path path_;
+    int fd_ = -1;
+    SeekableFileHeader header_{};
+    SeekableFileFooter footer_{};
+    std::vector<SeekableFrameIndexEntry> frames_;
+};
+
+} // namespace midas_file_unpacker_app
+
+#endif // MIDAS_FILE_UNPACKER_APP_IO_SEEKABLEMIDASFILE_H
@@ -0,0 +1,65 @@
+#ifndef MIDAS_FILE_UNPACKER_APP_IO_SEEKABLEMIDASFORMAT_H
+#define MIDAS_FILE_UNPACKER_APP_IO_SEEKABLEMIDASFORMAT_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace midas_file_unpacker_app {
+
+// Seekable MIDAS container (".mid.skz"), written by midas-recompress:
+//
+//   SeekableFileHeader
+//   frame 0 .. frame N-1      whole MIDAS events, each frame compressed independently
+//   SeekableFrameIndexEntry[N]
+//   SeekableFileFooter
+//
+// A frame is a sequence of ROOT compression blocks (R__zip, <= kSeekableMaxBlockBytes
+// of input each) or, when compression does not help, the raw bytes
+// (compressed_bytes == raw_bytes). Frames always end on an event boundary, so any frame
+// range can be decoded independently. Integers are stored in host byte order; readers
+// reject files whose byte_order mark does not match.
+
+constexpr char kSeekableHeaderMagic[8] = {'M', 'I', 'D', 'S', 'K', 'Z', 'H', '1'};
+constexpr char kSeekableFooterMagic[8] = {'M', 'I', 'D', 'S', 'K', 'Z', 'F', '1'};
+constexpr std::uint32_t kSeekableFormatVersion = 1;
+constexpr std::uint32_t kSeekableByteOrderMark = 0x01020304;
+constexpr std::size_t kSeekableDefaultFrameBytes = 4 * 1024 * 1024;
+constexpr std::size_t kSeekableMaxBlockBytes = 0xffffff; // ROOT's per-block limit
+constexpr std::uint64_t kSeekableMaxFrameBytes = std::uint64_t{1} << 30;
+// A MIDAS event is a 16-byte header plus a 32-bit data_size; a frame over the target size
+// holds exactly one such event.
+constexpr std::uint64_t kSeekableMaxEventBytes = 16 + std::uint64_t{0xffffffff};
+
+struct SeekableFileHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t byte_order;
+    std::uint64_t frame_target_bytes;
+    std::int32_t compression_settings;
+    std::uint32_t reserved;
+};
+
+struct SeekableFrameIndexEntry {
+    std::uint64_t offset;
+    std::uint64_t compressed_bytes;
+    std::uint64_t raw_bytes;
+    std::uint64_t first_event;
+    std::uint32_t event_count;
+    std::uint32_t reserved;
+};
+
+struct SeekableFileFooter {
+    std::uint64_t index_offset;
+    std::uint64_t frame_count;
+    std::uint64_t event_count;
+    std::uint64_t raw_bytes;
+    char magic[8];
+};
+
+static_assert(sizeof(SeekableFileHeader) == 32, "SeekableFileHeader layout changed");
+static_assert(sizeof(SeekableFrameIndexEntry) == 40, "SeekableFrameIndexEntry layout changed");
+static_assert(sizeof(SeekableFileFooter) == 40, "SeekableFileFooter layout changed");
+
+} // namespace midas_file_unpacker_app
+
+#endif // MIDAS_FILE_UNPACKER_APP_IO_SEEKABLEMIDASFORMAT_H
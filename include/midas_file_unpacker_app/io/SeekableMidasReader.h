@@ -0,0 +1,45 @@
+#ifndef MIDAS_FILE_UNPACKER_APP_IO_SEEKABLEMIDASREADER_H
+#define MIDAS_FILE_UNPACKER_APP_IO_SEEKABLEMIDASREADER_H
+
+#include "midasio.h"
+
+#include <cstddef>
+#include <future>
+#include <memory>
+#include <vector>
+
+namespace midas_file_unpacker_app {
+
+class SeekableMidasFile;
+
+/// TMReaderInterface over frames [first_frame, end_frame) of a seekable container.
+///
+/// The next frame is decompressed on a background thread while the current one is
+/// consumed. Readers over disjoint frame ranges of the same file can run concurrently.
+class SeekableMidasReader final : public TMReaderInterface {
+public:
+    SeekableMidasReader(std::shared_ptr<const SeekableMidasFile> file,
+                        std::size_t first_frame,
+                        std::size_t end_frame);
+    explicit SeekableMidasReader(std::shared_ptr<const SeekableMidasFile> file);
+    ~SeekableMidasReader() override;
+
+    int Read(void* buf, int count) override;
+    int Close() override;
+
+private:
+    bool advanceFrame();
+    void startPrefetch();
+
+    std::shared_ptr<const SeekableMidasFile> file_;
+    std::size_t next_frame_;
+    std::size_t end_frame_;
+
+    std::vector<char> current_;
+    std::size_t position_ = 0;
+    std::future<std::vector<char>> prefetch_;
+};
+
+} // namespace midas_file_unpacker_app
+
+#endif // MIDAS_FILE_UNPACKER_APP_IO_SEEKABLEMIDASREADER_H
@@ -0,0 +1,57 @@
+#ifndef MIDAS_FILE_UNPACKER_APP_IO_SEEKABLEMIDASWRITER_H
+#define MIDAS_FILE_UNPACKER_APP_IO_SEEKABLEMIDASWRITER_H
+
+#include "midas_file_unpacker_app/io/SeekableMidasFormat.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+namespace midas_file_unpacker_app {
+
+/// Packs whole MIDAS events into independently compressed frames plus a trailing index.
+///
+/// Only close() finalizes the file; a writer destroyed (or failing) before that deletes it.
+class SeekableMidasWriter {
+public:
+    SeekableMidasWriter(const std::filesystem::path& path, std::size_t frame_bytes, int compression_settings);
+    ~SeekableMidasWriter();
+
+    SeekableMidasWriter(const SeekableMidasWriter&) = delete;
+    SeekableMidasWriter& operator=(const SeekableMidasWriter&) = delete;
+
+    /// `data` must be one complete event (header + banks) as stored in a .mid file.
+    void writeEvent(const char* data, std::size_t size);
+    void close();
+
+    std::uint64_t eventCount() const { return event_count_; }
+    std::uint64_t frameCount() const { return index_.size(); }
+    std::uint64_t rawBytes() const { return raw_bytes_; }
+    std::uint64_t bytesWritten() const { return offset_; }
+
+private:
+    void flushFrame();
+    void discard() noexcept;
+    void writeBytes(const void* data, std::size_t size);
+
+    std::filesystem::path path_;
+    std::ofstream output_;
+    std::size_t frame_bytes_;
+    int compression_settings_;
+
+    std::vector<char> pending_;
+    std::vector<char> compressed_;
+    std::uint32_t pending_events_ = 0;
+
+    std::vector<SeekableFrameIndexEntry> index_;
+    std::uint64_t event_count_ = 0;
+    std::uint64_t raw_bytes_ = 0;
+    std::uint64_t offset_ = 0;
+    bool closed_ = false;
+};
+
+} // namespace midas_file_unpacker_app
+
+#endif // MIDAS_FILE_UNPACKER_APP_IO_SEEKABLEMIDASWRITER_H
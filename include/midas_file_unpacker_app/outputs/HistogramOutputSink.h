@@ -0,0 +1,33 @@
+#ifndef MIDAS_FILE_UNPACKER_APP_OUTPUTS_HISTOGRAMOUTPUTSINK_H
+#define MIDAS_FILE_UNPACKER_APP_OUTPUTS_HISTOGRAMOUTPUTSINK_H
+
+#include "midas_file_unpacker_app/outputs/OutputSink.h"
+
+#include <string>
+
+class TDirectory;
+class TH1D;
+
+namespace midas_file_unpacker_app {
+
+/// Monitoring histograms built from the per-event summary.
+class HistogramOutputSink final : public OutputSink {
+public:
+    explicit HistogramOutputSink(OutputSinkConfig config);
+
+    void close() override;
+    std::string description() const override;
+
+protected:
+    void openOutput(PipelineProfile& profile, OutputFileRegistry& files) override;
+    void fillEvent(const EventSummary& summary) override;
+
+private:
+    TDirectory* directory_ = nullptr;
+    TH1D* hit_count_ = nullptr;         // owned by directory_
+    TH1D* channel_occupancy_ = nullptr; // owned by directory_
+};
+
+} // namespace midas_file_unpacker_app
+
+#endif // MIDAS_FILE_UNPACKER_APP_OUTPUTS_HISTOGRAMOUTPUTSINK_H
@@ -0,0 +1,43 @@
+#ifndef MIDAS_FILE_UNPACKER_APP_OUTPUTS_OUTPUTFILEREGISTRY_H
+#define MIDAS_FILE_UNPACKER_APP_OUTPUTS_OUTPUTFILEREGISTRY_H
+
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+class TFile;
+
+namespace midas_file_unpacker_app {
+
+/// Opens each output ROOT file once so several sinks can write into the same file.
+class OutputFileRegistry {
+public:
+    OutputFileRegistry();
+    ~OutputFileRegistry();
+
+    OutputFileRegistry(const OutputFileRegistry&) = delete;
+    OutputFileRegistry& operator=(const OutputFileRegistry&) = delete;
+
+    /// The first sink to open a path decides the file-level compression.
+    TFile& open(const std::string& path, const std::optional<int>& compression_settings);
+    /// Held by every sink writing into `path`; profiles running concurrently may share a file.
+    std::mutex& fileMutex(const std::string& path);
+    void closeAll();
+
+private:
+    struct Entry {
+        std::string path;
+        std::unique_ptr<TFile> file;
+        std::unique_ptr<std::mutex> mutex;
+    };
+
+    Entry* find(const std::string& path);
+
+    std::vector<Entry> files_;
+};
+
+} // namespace midas_file_unpacker_app
+
+#endif // MIDAS_FILE_UNPACKER_APP_OUTPUTS_OUTPUTFILEREGISTRY_H
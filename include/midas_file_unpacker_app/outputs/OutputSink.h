@@ -0,0 +1,53 @@
+#ifndef MIDAS_FILE_UNPACKER_APP_OUTPUTS_OUTPUTSINK_H
+#define MIDAS_FILE_UNPACKER_APP_OUTPUTS_OUTPUTSINK_H
+
+#include "midas_file_unpacker_app/outputs/OutputSinkConfig.h"
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace midas_file_unpacker_app {
+
+class OutputFileRegistry;
+class PipelineProfile;
+struct EventSummary;
+
+/// One product written from the shared decode pass (tree, skim, histograms, ...).
+class OutputSink {
+public:
+    explicit OutputSink(OutputSinkConfig config);
+    virtual ~OutputSink() = default;
+
+    const OutputSinkConfig& config() const { return config_; }
+    const std::string& name() const { return config_.name; }
+    std::size_t entries() const { return entries_; }
+
+    bool accepts(const EventSummary& summary) const { return config_.selection.accepts(summary); }
+    /// Serialized against other sinks writing into the same file.
+    void fill(const EventSummary& summary);
+
+    /// Resolves references to other sinks; called once after all sinks are created.
+    virtual void link(const std::vector<std::unique_ptr<OutputSink>>& sinks);
+    void open(PipelineProfile& profile, OutputFileRegistry& files);
+    virtual void close() = 0;
+    virtual std::string description() const = 0;
+
+protected:
+    virtual void openOutput(PipelineProfile& profile, OutputFileRegistry& files) = 0;
+    virtual void fillEvent(const EventSummary& summary) = 0;
+
+    OutputSinkConfig config_;
+
+private:
+    std::size_t entries_ = 0;
+    std::mutex* file_mutex_ = nullptr;
+};
+
+std::vector<std::unique_ptr<OutputSink>> createOutputSinks(const std::vector<OutputSinkConfig>& configs);
+
+} // namespace midas_file_unpacker_app
+
+#endif // MIDAS_FILE_UNPACKER_APP_OUTPUTS_OUTPUTSINK_H
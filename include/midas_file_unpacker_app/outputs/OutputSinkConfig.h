@@ -0,0 +1,56 @@
+#ifndef MIDAS_FILE_UNPACKER_APP_OUTPUTS_OUTPUTSINKCONFIG_H
+#define MIDAS_FILE_UNPACKER_APP_OUTPUTS_OUTPUTSINKCONFIG_H
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace midas_file_unpacker_app {
+
+class PipelineProfile;
+struct EventSummary;
+
+enum class OutputSinkType {
+    Tree,
+    Histograms,
+    Summary
+};
+
+/// Per-sink event filter evaluated on the profile's EventSummary.
+struct EventSelection {
+    std::optional<std::uint32_t> min_hits;
+    std::optional<std::uint32_t> max_hits;
+    /// Event passes if it has a hit on any of these channels (0 = no requirement).
+    std::uint64_t any_channel_mask = 0;
+
+    bool empty() const { return !min_hits && !max_hits && any_channel_mask == 0; }
+    bool accepts(const EventSummary& summary) const;
+};
+
+/// One entry of the "outputs" array in an outputs config file.
+struct OutputSinkConfig {
+    std::string name;
+    OutputSinkType type = OutputSinkType::Tree;
+    std::string file = "output.root";
+    /// Tree name for tree/summary sinks, directory name for histogram sinks.
+    std::string object_name;
+    /// Summary sinks: tree output whose entry numbers are recorded (default: first tree output).
+    std::string events_output;
+    std::vector<std::string> branches;
+    EventSelection selection;
+    /// ROOT compression settings (algorithm * 100 + level). Unset: trees and summaries inherit
+    /// the file's compression, which the first output listed for the file decides.
+    std::optional<int> compression_settings;
+    std::uint32_t histogram_max_hits = 256;
+};
+
+std::vector<OutputSinkConfig> loadOutputSinkConfigs(const std::filesystem::path& path);
+/// Throws if a tree output asks for a branch the profile does not provide.
+void checkOutputBranches(const std::vector<OutputSinkConfig>& configs, const PipelineProfile& profile);
+
+} // namespace midas_file_unpacker_app
+
+#endif // MIDAS_FILE_UNPACKER_APP_OUTPUTS_OUTPUTSINKCONFIG_H
@@ -0,0 +1,43 @@
+#ifndef MIDAS_FILE_UNPACKER_APP_OUTPUTS_SUMMARYOUTPUTSINK_H
+#define MIDAS_FILE_UNPACKER_APP_OUTPUTS_SUMMARYOUTPUTSINK_H
+
+#include "midas_file_unpacker_app/outputs/OutputSink.h"
+#include "midas_file_unpacker_app/profiles/EventSummary.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+class TFile;
+class TTree;
+
+namespace midas_file_unpacker_app {
+
+/// Small per-event tree (hits, channel mask, timestamps, bank sizes) indexed by
+/// (midas_time, midas_serial), whose `entry` branch points into a full tree output.
+class SummaryOutputSink final : public OutputSink {
+public:
+    explicit SummaryOutputSink(OutputSinkConfig config);
+
+    void link(const std::vector<std::unique_ptr<OutputSink>>& sinks) override;
+    void close() override;
+    std::string description() const override;
+
+protected:
+    void openOutput(PipelineProfile& profile, OutputFileRegistry& files) override;
+    void fillEvent(const EventSummary& summary) override;
+
+private:
+    TFile* file_ = nullptr;
+    TTree* tree_ = nullptr; // owned by file_
+
+    const OutputSink* events_sink_ = nullptr;
+    bool events_sink_fills_first_ = false;
+
+    EventSummary record_;
+    long long entry_ = -1;
+};
+
+} // namespace midas_file_unpacker_app
+
+#endif // MIDAS_FILE_UNPACKER_APP_OUTPUTS_SUMMARYOUTPUTSINK_H
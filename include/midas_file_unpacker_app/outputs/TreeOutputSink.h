@@ -0,0 +1,32 @@
+#ifndef MIDAS_FILE_UNPACKER_APP_OUTPUTS_TREEOUTPUTSINK_H
+#define MIDAS_FILE_UNPACKER_APP_OUTPUTS_TREEOUTPUTSINK_H
+
+#include "midas_file_unpacker_app/outputs/OutputSink.h"
+
+#include <string>
+
+class TFile;
+class TTree;
+
+namespace midas_file_unpacker_app {
+
+/// Writes the profile's branches (optionally a subset) to a TTree.
+class TreeOutputSink final : public OutputSink {
+public:
+    explicit TreeOutputSink(OutputSinkConfig config);
+
+    void close() override;
+    std::string description() const override;
+
+protected:
+    void openOutput(PipelineProfile& profile, OutputFileRegistry& files) override;
+    void fillEvent(const EventSummary& summary) override;
+
+private:
+    TFile* file_ = nullptr;
+    TTree* tree_ = nullptr; // owned by file_
+};
+
+} // namespace midas_file_unpacker_app
+
+#endif // MIDAS_FILE_UNPACKER_APP_OUTPUTS_TREEOUTPUTSINK_H
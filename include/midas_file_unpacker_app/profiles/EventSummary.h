@@ -0,0 +1,69 @@
+#ifndef MIDAS_FILE_UNPACKER_APP_PROFILES_EVENTSUMMARY_H
+#define MIDAS_FILE_UNPACKER_APP_PROFILES_EVENTSUMMARY_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace midas_file_unpacker_app {
+
+/// Cheap per-event quantities shared by every output sink.
+///
+/// The profile fills the detector fields in summarizeEvent(); the app adds the MIDAS
+/// header fields afterwards, so reset() leaves those alone.
+struct EventSummary {
+    static constexpr std::size_t kMaxChannels = 64;
+    static constexpr std::size_t kMaxBanks = 32;
+
+    std::uint32_t hit_count = 0;
+    std::uint64_t channel_mask = 0;
+    std::array<std::uint32_t, kMaxChannels> channel_hits{};
+    /// Earliest detector timestamp in the event (profile-specific units, 0 if unknown).
+    double detector_time = 0.0;
+
+    std::uint32_t midas_serial = 0;
+    std::uint32_t midas_time = 0;
+    std::uint16_t midas_event_id = 0;
+    std::uint32_t midas_bytes = 0;
+    std::uint32_t midas_banks = 0;
+    /// First kMaxBanks banks in file order; names are the 4 ASCII characters packed little-endian.
+    std::uint32_t bank_entries = 0;
+    std::array<std::uint32_t, kMaxBanks> bank_names{};
+    std::array<std::uint32_t, kMaxBanks> bank_bytes{};
+
+    /// Channels outside [0, kMaxChannels) still count towards hit_count.
+    void addHit(long channel) {
+        ++hit_count;
+        if (channel < 0 || static_cast<std::size_t>(channel) >= kMaxChannels) {
+            return;
+        }
+        channel_mask |= (std::uint64_t{1} << channel);
+        ++channel_hits[static_cast<std::size_t>(channel)];
+    }
+
+    /// Banks past kMaxBanks still count towards midas_banks.
+    void addBank(const std::string& name, std::uint32_t bytes) {
+        if (bank_entries >= kMaxBanks) {
+            return;
+        }
+        std::uint32_t code = 0;
+        for (std::size_t i = 0; i < 4 && i < name.size(); ++i) {
+            code |= static_cast<std::uint32_t>(static_cast<unsigned char>(name[i])) << (8 * i);
+        }
+        bank_names[bank_entries] = code;
+        bank_bytes[bank_entries] = bytes;
+        ++bank_entries;
+    }
+
+    void reset() {
+        hit_count = 0;
+        channel_mask = 0;
+        channel_hits.fill(0);
+        detector_time = 0.0;
+    }
+};
+
+} // namespace midas_file_unpacker_app
+
+#endif // MIDAS_FILE_UNPACKER_APP_PROFILES_EVENTSUMMARY_H
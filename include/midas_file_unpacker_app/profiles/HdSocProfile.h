@@ -8,6 +8,7 @@
 #include <filesystem>
 #include <memory>
 #include <string>
+#include <vector>
 
 class PipelineDataProductManager;
 
@@ -26,16 +27,20 @@ public:
     std::string_view primaryKey() const override;
     std::string_view displayName() const override;
     std::filesystem::path configRelativePath() const override;
+    std::filesystem::path outputsConfigRelativePath() const override;
     PipelineMode mode() const override;
 
-    void setupTree(TTree& tree) override;
+    std::vector<std::string> branchNames() const override;
+    void setupTree(TTree& tree, const std::vector<std::string>& branches) override;
     bool extractEvent(PipelineDataProductManager& dpm) override;
+    void summarizeEvent(EventSummary& summary) const override;
     void resetEventState() override;
 
 private:
     std::string primary_key_;
     std::string display_name_;
     std::filesystem::path config_relative_path_;
+    std::filesystem::path outputs_config_relative_path_;
 
     PipelineDataProductReadLock event_lock_;
     PipelineDataProductReadLock time_lock_;
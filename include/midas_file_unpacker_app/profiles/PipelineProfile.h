@@ -1,15 +1,20 @@
 #ifndef MIDAS_FILE_UNPACKER_APP_PROFILES_PIPELINEPROFILE_H
 #define MIDAS_FILE_UNPACKER_APP_PROFILES_PIPELINEPROFILE_H
 
+#include <algorithm>
 #include <cstddef>
 #include <filesystem>
+#include <string>
 #include <string_view>
+#include <vector>
 
 class TTree;
 class PipelineDataProductManager;
 
 namespace midas_file_unpacker_app {
 
+struct EventSummary;
+
 enum class PipelineMode {
     Sampic,
     HdSoc
@@ -23,11 +28,22 @@ public:
     virtual std::string_view primaryKey() const = 0;
     virtual std::string_view displayName() const = 0;
     virtual std::filesystem::path configRelativePath() const = 0;
+    virtual std::filesystem::path outputsConfigRelativePath() const = 0;
     virtual PipelineMode mode() const = 0;
 
-    virtual void setupTree(TTree& tree) = 0;
+    /// Names accepted by setupTree(); an empty selection books all of them.
+    virtual std::vector<std::string> branchNames() const = 0;
+
+    /// May be called on several trees; all of them read the same per-event pointers.
+    virtual void setupTree(TTree& tree, const std::vector<std::string>& branches) = 0;
     virtual bool extractEvent(PipelineDataProductManager& dpm) = 0;
+    virtual void summarizeEvent(EventSummary& summary) const = 0;
     virtual void resetEventState() = 0;
+
+protected:
+    static bool branchRequested(const std::vector<std::string>& branches, std::string_view name) {
+        return branches.empty() || std::find(branches.begin(), branches.end(), name) != branches.end();
+    }
 };
 
 } // namespace midas_file_unpacker_app
@@ -24,7 +24,7 @@ show_help() {
     echo "  -d, --debug          Run with gdb for debugging"
     echo "  -v, --valgrind       Run with valgrind for memory analysis"
     echo "  --preload <libs>     Comma-separated list of library paths to LD_PRELOAD"
-    echo "  --profile <name>     Select pipeline profile (forwarded to unpacker unless provided after '--')"
+    echo "  --profile <name>     Select pipeline profile(s), comma-separated (forwarded to unpacker unless provided after '--')"
     echo
     echo "Arguments after '--' must include:"
     echo "  input_midas_file      Path to input MIDAS file"
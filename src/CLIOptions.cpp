@@ -2,6 +2,7 @@
 
 #include "midas_file_unpacker_app/profiles/ProfileRegistry.h"
 
+#include <algorithm>
 #include <cctype>
 #include <iostream>
 #include <optional>
@@ -30,11 +31,27 @@ std::size_t parsePositiveSizeT(const std::string& value) {
     return static_cast<std::size_t>(parsed);
 }
 
+std::vector<std::string> parseStringList(const std::string& value) {
+    std::vector<std::string> values;
+    std::stringstream stream(value);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        if (item.empty()) {
+            throw std::runtime_error("Empty entry in comma-separated list: '" + value + "'");
+        }
+        values.push_back(item);
+    }
+    if (values.empty()) {
+        throw std::runtime_error("Expected a comma-separated list: '" + value + "'");
+    }
+    return values;
+}
+
 } // namespace
 
 CLIOptions parseCommandLine(int argc, char** argv, const ProfileRegistry& registry) {
     CLIOptions options;
-    options.profileKey = registry.defaultProfileKey();
+    options.profileKeys = {registry.defaultProfileKey()};
 
     bool treat_as_positional = false;
 
@@ -55,7 +72,44 @@ CLIOptions parseCommandLine(int argc, char** argv, const ProfileRegistry& regist
             if (i + 1 >= argc) {
                 throw std::runtime_error("--profile requires a value");
             }
-            options.profileKey = registry.normalizeKey(argv[++i]);
+            options.profileKeys.clear();
+            for (const auto& key : parseStringList(argv[++i])) {
+                options.profileKeys.push_back(registry.normalizeKey(key));
+            }
+            continue;
+        }
+
+        if (!treat_as_positional && arg == "--outputs") {
+            if (i + 1 >= argc) {
+                throw std::runtime_error("--outputs requires a path to an outputs config file");
+            }
+            options.outputsConfigs = parseStringList(argv[++i]);
+            continue;
+        }
+
+        if (!treat_as_positional && arg == "--cache-dir") {
+            if (i + 1 >= argc) {
+                throw std::runtime_error("--cache-dir requires a directory");
+            }
+            options.cacheDir = argv[++i];
+            continue;
+        }
+
+        if (!treat_as_positional && arg == "--cache-max-gb") {
+            if (i + 1 >= argc) {
+                throw std::runtime_error("--cache-max-gb requires a positive integer value");
+            }
+            options.cacheMaxGiB = parsePositiveSizeT(argv[++i]);
+            continue;
+        }
+
+        if (!treat_as_positional && arg == "--track-allocations") {
+            options.trackAllocations = true;
+            continue;
+        }
+
+        if (!treat_as_positional && arg == "--stage-timing") {
+            options.stageTiming = true;
             continue;
         }
 
@@ -93,9 +147,26 @@ CLIOptions parseCommandLine(int argc, char** argv, const ProfileRegistry& regist
         throw std::runtime_error("Missing required <input_midas_file> argument");
     }
 
-    if (!registry.hasProfile(options.profileKey)) {
+    std::vector<const PipelineProfile*> selected;
+    for (const auto& key : options.profileKeys) {
+        if (!registry.hasProfile(key)) {
+            std::ostringstream oss;
+            oss << "Unknown profile '" << key << "'";
+            throw std::runtime_error(oss.str());
+        }
+        const PipelineProfile* profile = registry.getProfile(key).get();
+        if (std::find(selected.begin(), selected.end(), profile) != selected.end()) {
+            std::ostringstream oss;
+            oss << "Profile '" << key << "' selected more than once";
+            throw std::runtime_error(oss.str());
+        }
+        selected.push_back(profile);
+    }
+
+    if (!options.outputsConfigs.empty() && options.outputsConfigs.size() != options.profileKeys.size()) {
         std::ostringstream oss;
-        oss << "Unknown profile '" << options.profileKey << "'";
+        oss << "--outputs lists " << options.outputsConfigs.size() << " config(s) for "
+            << options.profileKeys.size() << " profile(s)";
         throw std::runtime_error(oss.str());
     }
 
@@ -105,8 +176,13 @@ CLIOptions parseCommandLine(int argc, char** argv, const ProfileRegistry& regist
 void printUsage(const char* program, const ProfileRegistry& registry) {
     std::cout << "Usage: " << program << " [OPTIONS] <input_midas_file> [max_events]\n\n"
               << "Options:\n"
-              << "  --profile <name>     Select pipeline profile\n"
+              << "  --profile <name,...> Select pipeline profile(s); several share one read of the input\n"
               << "  --max-events <N>     Limit number of events to process\n"
+              << "  --outputs <file,...> Outputs config per profile (default: each profile's default_outputs.json)\n"
+              << "  --cache-dir <dir>    Reuse/store outputs in a content-addressed cache\n"
+              << "  --cache-max-gb <N>   Evict least recently used cache entries above N GiB (default 50)\n"
+              << "  --track-allocations  Report heap allocations per processing phase and RSS\n"
+              << "  --stage-timing       Time each per-event step and project what batching could save\n"
               << "  --help               Show this help message\n\n"
               << "Available profiles:\n";
 
@@ -116,7 +192,9 @@ void printUsage(const char* program, const ProfileRegistry& registry) {
 
     std::cout << "\nExamples:\n"
               << "  " << program << " run00156.mid.lz4\n"
-              << "  " << program << " --profile HDSoC run00156.mid.lz4 --max-events 5000\n";
+              << "  " << program << " --profile HDSoC run00156.mid.lz4 --max-events 5000\n"
+              << "  " << program << " --profile SAMPIC,HDSoC run00156.mid.lz4\n"
+              << "  " << program << " --outputs config/unpacker_outputs/SAMPIC/fanout_outputs.json run00156.mid.lz4\n";
 }
 
 } // namespace midas_file_unpacker_app
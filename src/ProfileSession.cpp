@@ -0,0 +1,170 @@
+#include "midas_file_unpacker_app/ProfileSession.h"
+
+#include "midas_file_unpacker_app/diagnostics/AllocationTracker.h"
+#include "midas_file_unpacker_app/io/BatchQueue.h"
+#include "midas_file_unpacker_app/io/EventBatch.h"
+#include "midas_file_unpacker_app/outputs/OutputSink.h"
+#include "midas_file_unpacker_app/profiles/PipelineProfile.h"
+
+#include "analysis_pipeline/config/config_manager.h"
+#include "analysis_pipeline/core/context/input_bundle.h"
+#include "analysis_pipeline/pipeline/pipeline.h"
+
+#include "midasio.h"
+
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+
+namespace midas_file_unpacker_app {
+
+ProfileSession::ProfileSession(std::shared_ptr<PipelineProfile> profile,
+                               std::filesystem::path pipeline_config_path,
+                               std::filesystem::path logger_config_path,
+                               std::filesystem::path outputs_config_path,
+                               std::vector<OutputSinkConfig> sink_configs)
+    : profile_(std::move(profile)),
+      pipeline_config_path_(std::move(pipeline_config_path)),
+      logger_config_path_(std::move(logger_config_path)),
+      outputs_config_path_(std::move(outputs_config_path)),
+      sink_configs_(std::move(sink_configs)),
+      sinks_(createOutputSinks(sink_configs_)) {}
+
+ProfileSession::~ProfileSession() {
+    if (worker_.joinable()) {
+        queue_->close();
+        worker_.join();
+    }
+}
+
+std::vector<std::string> ProfileSession::configFiles() const {
+    return {logger_config_path_.string(), pipeline_config_path_.string()};
+}
+
+void ProfileSession::buildPipeline() {
+    config_manager_ = std::make_shared<ConfigManager>();
+    if (!config_manager_->loadFiles(configFiles()) || !config_manager_->validate()) {
+        throw std::runtime_error("Failed to load or validate config files for profile "
+                                 + std::string(profile_->displayName()));
+    }
+
+    pipeline_ = std::make_unique<Pipeline>(config_manager_);
+    if (!pipeline_->buildFromConfig()) {
+        throw std::runtime_error("Failed to build pipeline from config: " + pipeline_config_path_.string());
+    }
+}
+
+void ProfileSession::openOutputs(OutputFileRegistry& files) {
+    // Every sink reads the same extracted products, so each event is decoded exactly once.
+    for (auto& sink : sinks_) {
+        sink->open(*profile_, files);
+    }
+    outputs_open_ = true;
+}
+
+void ProfileSession::closeOutputs() {
+    for (auto& sink : sinks_) {
+        sink->close();
+    }
+    outputs_open_ = false;
+}
+
+void ProfileSession::processBatch(const EventBatch& batch) {
+    for (const auto& event : batch) {
+        processEvent(event);
+        events_processed_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void ProfileSession::processEvent(const std::shared_ptr<TMEvent>& event) {
+    // The profile's pointers into the data products stay valid until resetEventState().
+    StageTimes* times = stage_times_ ? &*stage_times_ : nullptr;
+    {
+        ScopedRunPhase phase(RunPhase::Input);
+        ScopedStageTimer timer(times, RunPhase::Input);
+        InputBundle input;
+        input.set("TMEvent", event);
+        pipeline_->setInputData(std::move(input));
+    }
+    {
+        ScopedRunPhase phase(RunPhase::Pipeline);
+        ScopedStageTimer timer(times, RunPhase::Pipeline);
+        pipeline_->execute();
+    }
+
+    bool extracted = false;
+    {
+        ScopedRunPhase phase(RunPhase::Extract);
+        ScopedStageTimer timer(times, RunPhase::Extract);
+        extracted = profile_->extractEvent(pipeline_->getDataProductManager());
+        if (extracted) {
+            profile_->summarizeEvent(summary_);
+
+            event->FindAllBanks();
+            summary_.midas_serial = event->serial_number;
+            summary_.midas_time = event->time_stamp;
+            summary_.midas_event_id = event->event_id;
+            summary_.midas_bytes = event->data_size;
+            summary_.midas_banks = static_cast<std::uint32_t>(event->banks.size());
+            summary_.bank_entries = 0;
+            for (const auto& bank : event->banks) {
+                summary_.addBank(bank.name, bank.data_size);
+            }
+        }
+    }
+
+    if (extracted && outputs_open_) {
+        ScopedRunPhase phase(RunPhase::Fill);
+        ScopedStageTimer timer(times, RunPhase::Fill);
+        for (auto& sink : sinks_) {
+            if (sink->accepts(summary_)) {
+                sink->fill(summary_);
+            }
+        }
+    }
+
+    ScopedRunPhase phase(RunPhase::Clear);
+    ScopedStageTimer timer(times, RunPhase::Clear);
+    profile_->resetEventState();
+    pipeline_->getDataProductManager().clear();
+}
+
+void ProfileSession::start(std::size_t queue_capacity) {
+    if (worker_.joinable()) {
+        throw std::logic_error("ProfileSession worker already running");
+    }
+    queue_ = std::make_unique<BatchQueue>(queue_capacity);
+    worker_error_ = nullptr;
+    failed_.store(false, std::memory_order_relaxed);
+    worker_ = std::thread(&ProfileSession::workerLoop, this);
+}
+
+void ProfileSession::submit(std::shared_ptr<const EventBatch> batch) {
+    queue_->push(std::move(batch));
+}
+
+std::exception_ptr ProfileSession::finish() {
+    if (!worker_.joinable()) {
+        return nullptr;
+    }
+    queue_->close();
+    worker_.join();
+    queue_.reset();
+    return worker_error_;
+}
+
+void ProfileSession::workerLoop() {
+    while (auto batch = queue_->pop()) {
+        if (failed()) {
+            continue; // keep draining so the reader never blocks on a dead worker
+        }
+        try {
+            processBatch(*batch);
+        } catch (...) {
+            worker_error_ = std::current_exception();
+            failed_.store(true, std::memory_order_relaxed);
+        }
+    }
+}
+
+} // namespace midas_file_unpacker_app
@@ -1,25 +1,38 @@
 #include "midas_file_unpacker_app/UnpackerApp.h"
 
 #include "midas_file_unpacker_app/CLIOptions.h"
+#include "midas_file_unpacker_app/ProfileSession.h"
+#include "midas_file_unpacker_app/cache/CacheKeyBuilder.h"
+#include "midas_file_unpacker_app/cache/OutputCache.h"
+#include "midas_file_unpacker_app/diagnostics/AllocationTracker.h"
+#include "midas_file_unpacker_app/diagnostics/MemoryUsage.h"
+#include "midas_file_unpacker_app/diagnostics/StageTimer.h"
+#include "midas_file_unpacker_app/io/EventBatch.h"
+#include "midas_file_unpacker_app/io/MidasReader.h"
+#include "midas_file_unpacker_app/outputs/OutputFileRegistry.h"
+#include "midas_file_unpacker_app/outputs/OutputSink.h"
 #include "midas_file_unpacker_app/profiles/ProfileRegistry.h"
 
-#include <TFile.h>
-#include <TTree.h>
+#include "midasio.h"
 
-#include "analysis_pipeline/config/config_manager.h"
-#include "analysis_pipeline/core/context/input_bundle.h"
-#include "analysis_pipeline/pipeline/pipeline.h"
+#include <TROOT.h>
 
-#include "midasio.h"
+#include <nlohmann/json.hpp>
 
 #include <algorithm>
+#include <array>
 #include <chrono>
 #include <filesystem>
+#include <fstream>
+#include <functional>
 #include <iomanip>
 #include <iostream>
 #include <memory>
+#include <optional>
 #include <stdexcept>
 #include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 
 namespace midas_file_unpacker_app {
@@ -27,17 +40,288 @@ namespace midas_file_unpacker_app {
 namespace {
 
 constexpr std::size_t kDefaultMaxEvents = 10'000'000;
+constexpr std::uintmax_t kBytesPerGiB = std::uintmax_t{1} << 30;
+constexpr double kBytesPerMiB = 1024.0 * 1024.0;
+// Events read per hand-off. The pipeline API takes one TMEvent per execute(), so this only
+// sets how often the reader synchronizes with the profile workers.
+constexpr std::size_t kEventsPerBatch = 16;
+// How far the reader may run ahead of the slowest profile when several run concurrently.
+constexpr std::size_t kQueuedBatchesPerProfile = 4;
+// Events per execute() that the stage timing report projects throughput for.
+constexpr std::array<std::size_t, 5> kProjectedBatchSizes = {1, 4, 16, 64, 256};
+// Bump when the output layout changes in a way the hashed inputs do not capture.
+constexpr const char* kCacheFormatVersion = "1";
 
-struct ReaderDeleter {
-    void operator()(TMReaderInterface* reader) const {
-        delete reader;
+std::filesystem::path resolveBaseDir() {
+    return std::filesystem::path(__FILE__).parent_path().parent_path();
+}
+
+std::size_t readBatch(EventBatch& batch, TMReaderInterface& reader, std::size_t limit) {
+    ScopedRunPhase phase(RunPhase::Read);
+    return batch.read(reader, limit);
+}
+
+using Sessions = std::vector<std::unique_ptr<ProfileSession>>;
+
+/// Joins every worker before reporting the first error, so no sink is still filling when
+/// the output files are closed during unwinding.
+void finishSessions(Sessions& sessions) {
+    std::exception_ptr first_error;
+    for (auto& session : sessions) {
+        std::exception_ptr error = session->finish();
+        if (error && !first_error) {
+            first_error = error;
+        }
     }
-};
+    if (first_error) {
+        std::rethrow_exception(first_error);
+    }
+}
 
-using ReaderPtr = std::unique_ptr<TMReaderInterface, ReaderDeleter>;
+bool anySessionFailed(const Sessions& sessions) {
+    return std::any_of(sessions.begin(), sessions.end(), [](const auto& session) { return session->failed(); });
+}
 
-std::filesystem::path resolveBaseDir() {
-    return std::filesystem::path(__FILE__).parent_path().parent_path();
+/// Events every session has finished decoding.
+std::size_t eventsProcessedByAll(const Sessions& sessions) {
+    std::size_t processed = sessions.front()->eventsProcessed();
+    for (const auto& session : sessions) {
+        processed = std::min(processed, session->eventsProcessed());
+    }
+    return processed;
+}
+
+/// Reads each batch once and hands it to every session; returns the number of events read.
+///
+/// A single session decodes inline. Several sessions each decode on their own thread,
+/// sharing the batches read-only; `on_batch` runs on the reader thread after each batch.
+std::size_t runSessions(Sessions& sessions,
+                        TMReaderInterface& reader,
+                        std::size_t total_events_to_process,
+                        const std::function<void()>& on_batch) {
+    const bool concurrent = sessions.size() > 1;
+    if (concurrent) {
+        for (auto& session : sessions) {
+            session->start(kQueuedBatchesPerProfile);
+        }
+    }
+
+    std::size_t event_count = 0;
+    try {
+        while (event_count < total_events_to_process && !anySessionFailed(sessions)) {
+            auto batch = std::make_shared<EventBatch>(kEventsPerBatch);
+            if (readBatch(*batch, reader, total_events_to_process - event_count) == 0) {
+                break;
+            }
+            event_count += batch->size();
+
+            if (concurrent) {
+                {
+                    // Index the banks up front: later FindAllBanks() calls return early, so
+                    // the pipelines only ever read the shared events.
+                    ScopedRunPhase phase(RunPhase::Read);
+                    for (const auto& event : *batch) {
+                        event->FindAllBanks();
+                    }
+                }
+                for (auto& session : sessions) {
+                    session->submit(batch);
+                }
+            } else {
+                sessions.front()->processBatch(*batch);
+            }
+            {
+                ScopedRunPhase phase(RunPhase::Clear);
+                batch.reset();
+            }
+
+            if (on_batch) {
+                on_batch();
+            }
+        }
+    } catch (...) {
+        // The reader's error is the one to report; worker errors are usually its fallout.
+        for (auto& session : sessions) {
+            session->finish();
+        }
+        throw;
+    }
+
+    finishSessions(sessions);
+    return event_count;
+}
+
+std::string sessionNames(const Sessions& sessions) {
+    std::string names;
+    for (const auto& session : sessions) {
+        if (!names.empty()) {
+            names += " + ";
+        }
+        names += session->profile().displayName();
+    }
+    return names;
+}
+
+void printAllocationRow(const char* label, const PhaseAllocationStats& stats) {
+    std::cout << std::left << std::setw(10) << label << std::right
+              << std::setw(14) << stats.allocations
+              << std::setw(14) << std::fixed << std::setprecision(2)
+              << static_cast<double>(stats.allocated_bytes) / kBytesPerMiB
+              << std::setw(14) << stats.frees
+              << std::setw(12) << static_cast<double>(stats.live_bytes) / kBytesPerMiB
+              << std::setw(16) << static_cast<double>(stats.peak_live_bytes) / kBytesPerMiB << "\n";
+}
+
+/// Each row covers the blocks allocated in that phase: its frees, what is still live and
+/// the most it held at once. Per-phase rows need a single decoding thread; with several
+/// profiles the phases of concurrent workers overwrite each other, so only totals are shown.
+void printAllocationReport(bool per_phase) {
+    std::cout << std::left << std::setw(10) << "Phase" << std::right
+              << std::setw(14) << "Allocs" << std::setw(14) << "Alloc MiB"
+              << std::setw(14) << "Frees" << std::setw(12) << "Live MiB"
+              << std::setw(16) << "Peak live MiB" << "\n";
+    const auto stats = AllocationTracker::snapshot();
+    PhaseAllocationStats total;
+    for (std::size_t i = 0; i < kNumRunPhases; ++i) {
+        total.allocations += stats[i].allocations;
+        total.allocated_bytes += stats[i].allocated_bytes;
+        total.frees += stats[i].frees;
+        if (per_phase && (stats[i].allocations > 0 || stats[i].frees > 0)) {
+            printAllocationRow(runPhaseName(static_cast<RunPhase>(i)), stats[i]);
+        }
+    }
+    total.live_bytes = AllocationTracker::liveBytes();
+    total.peak_live_bytes = AllocationTracker::peakLiveBytes();
+    printAllocationRow("total", total);
+}
+
+double seconds(std::chrono::steady_clock::duration duration) {
+    return std::chrono::duration_cast<std::chrono::duration<double>>(duration).count();
+}
+
+/// Time per step for one profile, and the throughput it would reach if setInputData and
+/// the product clear were paid once per K events. execute() is projected unchanged: its
+/// per-call dispatch cost cannot be told apart from decoding, so the gain is a lower bound.
+void printStageTimingReport(const ProfileSession& session, std::size_t events) {
+    const StageTimes& times = *session.stageTimes();
+    constexpr std::array<RunPhase, 5> kSteps = {
+        RunPhase::Input, RunPhase::Pipeline, RunPhase::Extract, RunPhase::Fill, RunPhase::Clear};
+    const double per_event = 1e6 / static_cast<double>(std::max<std::size_t>(events, 1));
+
+    double total = 0.0;
+    for (RunPhase step : kSteps) {
+        total += seconds(times[step]);
+    }
+
+    std::cout << "Stage timing [" << session.profile().primaryKey() << "]:\n";
+    std::cout << std::left << std::setw(10) << "Step" << std::right
+              << std::setw(12) << "Total s" << std::setw(12) << "us/event" << std::setw(10) << "Share" << "\n";
+    for (RunPhase step : kSteps) {
+        const double step_seconds = seconds(times[step]);
+        std::cout << std::left << std::setw(10) << runPhaseName(step) << std::right << std::fixed
+                  << std::setw(12) << std::setprecision(3) << step_seconds
+                  << std::setw(12) << std::setprecision(2) << step_seconds * per_event
+                  << std::setw(9) << std::setprecision(1) << (total > 0.0 ? 100.0 * step_seconds / total : 0.0)
+                  << "%\n";
+    }
+    std::cout << std::left << std::setw(10) << "total" << std::right << std::fixed
+              << std::setw(12) << std::setprecision(3) << total
+              << std::setw(12) << std::setprecision(2) << total * per_event << "\n";
+
+    const double amortizable = seconds(times[RunPhase::Input]) + seconds(times[RunPhase::Clear]);
+    const double fixed = total - amortizable;
+    std::cout << "Projected events/s with K events per execute() (input and clear paid once per K):\n";
+    for (std::size_t batch_size : kProjectedBatchSizes) {
+        const double projected = fixed + amortizable / static_cast<double>(batch_size);
+        std::cout << "  K=" << std::left << std::setw(6) << batch_size << std::right << std::setw(14)
+                  << std::setprecision(2) << (projected > 0.0 ? static_cast<double>(events) / projected : 0.0)
+                  << "\n";
+    }
+}
+
+/// `output.root` -> `output_<key>.root`, keeping profiles' default outputs apart.
+std::string withProfileSuffix(const std::string& path, std::string_view key) {
+    std::filesystem::path file(path);
+    const std::string stem = file.stem().string() + "_" + std::string(key);
+    return (file.parent_path() / (stem + file.extension().string())).string();
+}
+
+/// Two profiles may share an output file, but not an object inside it. The first profile
+/// to open a file also decides the compression its histograms are written with.
+void checkOutputCollisions(const Sessions& sessions) {
+    std::vector<std::pair<std::string, std::string>> seen;
+    std::vector<const OutputSinkConfig*> file_owners;
+    for (const auto& session : sessions) {
+        for (const auto& config : session->sinkConfigs()) {
+            auto key = std::make_pair(config.file, config.object_name);
+            if (std::find(seen.begin(), seen.end(), key) != seen.end()) {
+                throw std::runtime_error("Output '" + key.second + "' is written to " + key.first
+                                         + " by more than one profile; give each profile its own "
+                                           "tree_name/directory or file");
+            }
+            seen.push_back(std::move(key));
+
+            const auto owner = std::find_if(file_owners.begin(), file_owners.end(),
+                                            [&](const OutputSinkConfig* other) { return other->file == config.file; });
+            if (owner == file_owners.end()) {
+                file_owners.push_back(&config);
+            } else if (config.type == OutputSinkType::Histograms && config.compression_settings
+                       && config.compression_settings != (*owner)->compression_settings) {
+                throw std::runtime_error("Output '" + config.name + "': histograms use the compression of "
+                                         + config.file + ", which is set by output '" + (*owner)->name + "'");
+            }
+        }
+    }
+}
+
+std::vector<std::string> uniqueOutputFiles(const Sessions& sessions) {
+    std::vector<std::string> files;
+    for (const auto& session : sessions) {
+        for (const auto& config : session->sinkConfigs()) {
+            std::string path = std::filesystem::path(config.file).lexically_normal().string();
+            if (std::find(files.begin(), files.end(), path) == files.end()) {
+                files.push_back(std::move(path));
+            }
+        }
+    }
+    return files;
+}
+
+std::vector<std::filesystem::path> pluginLibraries(const std::filesystem::path& pipeline_config_path,
+                                                   const std::filesystem::path& base_dir) {
+    std::ifstream input(pipeline_config_path);
+    const auto config = nlohmann::json::parse(input, nullptr, false);
+    std::vector<std::filesystem::path> libraries;
+    if (config.is_discarded() || !config.contains("plugin_libraries")) {
+        return libraries;
+    }
+    for (const auto& entry : config.at("plugin_libraries")) {
+        std::filesystem::path library(entry.get<std::string>());
+        libraries.push_back(library.is_absolute() ? library : base_dir / library);
+    }
+    return libraries;
+}
+
+std::string computeCacheKey(const Sessions& sessions,
+                            const std::filesystem::path& input_path,
+                            const std::filesystem::path& base_dir,
+                            std::size_t max_events) {
+    CacheKeyBuilder builder;
+    builder.addString("format", kCacheFormatVersion)
+        .addString("max_events", std::to_string(max_events))
+        .addInputIdentity(input_path);
+    for (const auto& session : sessions) {
+        builder.addString("profile", std::string(session->profile().primaryKey()))
+            .addFileContents(session->outputsConfigPath());
+        for (const auto& config_file : session->configFiles()) {
+            builder.addFileContents(config_file);
+        }
+        for (const auto& library : pluginLibraries(session->pipelineConfigPath(), base_dir)) {
+            builder.addFileStamp(library);
+        }
+    }
+    builder.addFileStamp("/proc/self/exe");
+    return builder.finish();
 }
 
 } // namespace
@@ -46,7 +330,10 @@ UnpackerApp::UnpackerApp(const ProfileRegistry& registry)
     : registry_(registry) {}
 
 int UnpackerApp::run(const CLIOptions& options) const {
-    auto profile = registry_.getProfile(options.profileKey);
+    if (options.trackAllocations) {
+        AllocationTracker::enable();
+    }
+
     const std::size_t max_events_requested = options.maxEvents.value_or(kDefaultMaxEvents);
 
     std::filesystem::path input_path(options.inputFile);
@@ -55,56 +342,109 @@ int UnpackerApp::run(const CLIOptions& options) const {
     }
 
     std::filesystem::path base_dir = resolveBaseDir();
-    std::filesystem::path pipeline_config_path = base_dir / profile->configRelativePath();
-    if (!std::filesystem::exists(pipeline_config_path)) {
-        throw std::runtime_error("Pipeline config file not found: " + pipeline_config_path.string());
-    }
+    const bool multi_profile = options.profileKeys.size() > 1;
+    // Declared before the sessions so that, on unwinding, every worker has been joined
+    // before the files holding its trees are closed.
+    OutputFileRegistry output_files;
+    Sessions sessions;
+    for (std::size_t i = 0; i < options.profileKeys.size(); ++i) {
+        auto profile = registry_.getProfile(options.profileKeys[i]);
+
+        std::filesystem::path pipeline_config_path = base_dir / profile->configRelativePath();
+        if (!std::filesystem::exists(pipeline_config_path)) {
+            throw std::runtime_error("Pipeline config file not found: " + pipeline_config_path.string());
+        }
 
-    std::vector<std::string> config_files = {
-        (base_dir / "config/logger.json").string(),
-        pipeline_config_path.string()
-    };
+        const bool default_outputs = options.outputsConfigs.empty();
+        std::filesystem::path outputs_config_path = default_outputs
+            ? base_dir / profile->outputsConfigRelativePath()
+            : std::filesystem::path(options.outputsConfigs[i]);
+        if (!std::filesystem::exists(outputs_config_path)) {
+            throw std::runtime_error("Outputs config file not found: " + outputs_config_path.string());
+        }
+        auto sink_configs = loadOutputSinkConfigs(outputs_config_path);
+        checkOutputBranches(sink_configs, *profile);
+        if (multi_profile && default_outputs) {
+            for (auto& config : sink_configs) {
+                config.file = withProfileSuffix(config.file, profile->primaryKey());
+            }
+        }
 
-    auto config_manager = std::make_shared<ConfigManager>();
-    if (!config_manager->loadFiles(config_files) || !config_manager->validate()) {
-        throw std::runtime_error("Failed to load or validate config files");
+        sessions.push_back(std::make_unique<ProfileSession>(
+            std::move(profile), std::move(pipeline_config_path), base_dir / "config/logger.json",
+            std::move(outputs_config_path), std::move(sink_configs)));
     }
-
-    Pipeline pipeline(config_manager);
-    if (!pipeline.buildFromConfig()) {
-        throw std::runtime_error("Failed to build pipeline from config");
+    checkOutputCollisions(sessions);
+    if (options.stageTiming) {
+        for (auto& session : sessions) {
+            session->enableStageTiming();
+        }
+    }
+    const auto output_paths = uniqueOutputFiles(sessions);
+
+    std::optional<OutputCache> cache;
+    std::string cache_key;
+    if (!options.cacheDir.empty()) {
+        cache.emplace(options.cacheDir, options.cacheMaxGiB * kBytesPerGiB);
+        cache_key = computeCacheKey(sessions, input_path, base_dir, max_events_requested);
+
+        if (cache->restore(cache_key, output_paths)) {
+            std::cout << "Cache hit: " << (cache->directory() / cache_key).string() << "\n";
+            for (const auto& path : output_paths) {
+                std::cout << "  restored " << path << "\n";
+            }
+            return EXIT_SUCCESS;
+        }
+        std::cout << "Cache miss: " << cache_key << "\n";
     }
 
-    ReaderPtr count_reader(TMNewReader(input_path.string().c_str()));
-    if (!count_reader) {
-        throw std::runtime_error("Failed to open MIDAS file for counting: " + input_path.string());
+    if (multi_profile) {
+        ROOT::EnableThreadSafety();
+    }
+    for (auto& session : sessions) {
+        session->buildPipeline();
     }
 
+    // Seekable containers carry their event count in the index; anything else is counted.
     std::size_t total_events_in_file = 0;
-    while (TMReadEvent(count_reader.get()) != nullptr) {
-        ++total_events_in_file;
+    if (const auto indexed_count = indexedEventCount(input_path)) {
+        total_events_in_file = *indexed_count;
+    } else {
+        ScopedRunPhase phase(RunPhase::Count);
+        ReaderPtr count_reader = openMidasReader(input_path);
+        if (!count_reader) {
+            throw std::runtime_error("Failed to open MIDAS file for counting: " + input_path.string());
+        }
+        while (TMEvent* counted_event = TMReadEvent(count_reader.get())) {
+            delete counted_event;
+            ++total_events_in_file;
+        }
+        if (count_reader->fError) {
+            throw std::runtime_error("Failed to count events in " + input_path.string() + ": "
+                                     + count_reader->fErrorString);
+        }
     }
-    count_reader.reset();
 
     const std::size_t total_events_to_process = std::min(max_events_requested, total_events_in_file);
 
-    std::cout << "Using pipeline profile: " << profile->displayName()
-              << " (" << pipeline_config_path.string() << ")\n";
+    for (const auto& session : sessions) {
+        std::cout << "Using pipeline profile: " << session->profile().displayName()
+                  << " (" << session->pipelineConfigPath().string() << ")\n";
+        std::cout << "Outputs config: " << session->outputsConfigPath().string() << "\n";
+    }
     std::cout << "Input file: " << input_path.string() << "\n";
     std::cout << "Total events in file: " << total_events_in_file << "\n";
     std::cout << "Events to process: " << total_events_to_process << "\n";
 
-    ReaderPtr reader(TMNewReader(input_path.string().c_str()));
+    ReaderPtr reader = openMidasReader(input_path);
     if (!reader) {
         throw std::runtime_error("Failed to reopen MIDAS file: " + input_path.string());
     }
 
-    TFile output_file("output.root", "RECREATE");
-    const std::string tree_title = std::string(profile->displayName()) + " unpacked events";
-    TTree tree("events", tree_title.c_str());
-    profile->setupTree(tree);
+    for (auto& session : sessions) {
+        session->openOutputs(output_files);
+    }
 
-    std::size_t event_count = 0;
     const auto t_start = std::chrono::steady_clock::now();
     const double progress_update_percent = 5.0;
     std::size_t next_progress_event = 0;
@@ -114,51 +454,47 @@ int UnpackerApp::run(const CLIOptions& options) const {
     std::cout << "[Progress] 0.0% (0/" << total_events_to_process
               << ") | Time: 0.00 s | Rate: 0.00 events/s\n";
 
-    while (event_count < total_events_to_process) {
-        ++event_count;
-        TMEvent* raw_event = TMReadEvent(reader.get());
-        if (!raw_event) {
-            break;
+    // Counts events decoded by every profile, not events read ahead of the workers.
+    std::size_t last_reported = 0;
+    const auto report_progress = [&]() {
+        const std::size_t event_count = eventsProcessedByAll(sessions);
+        if (event_count == last_reported
+            || (event_count < next_progress_event && event_count != total_events_to_process)) {
+            return;
         }
-
-        std::shared_ptr<TMEvent> wrapped_event(raw_event);
-
-        InputBundle input;
-        input.set("TMEvent", wrapped_event);
-        pipeline.setInputData(std::move(input));
-        pipeline.execute();
-
-        auto& dpm = pipeline.getDataProductManager();
-
-        if (!profile->extractEvent(dpm)) {
-            profile->resetEventState();
-            dpm.clear();
-            continue;
+        last_reported = event_count;
+        const double elapsed = std::chrono::duration_cast<std::chrono::duration<double>>(
+            std::chrono::steady_clock::now() - t_start).count();
+        const double eps = (elapsed > 0.0) ? static_cast<double>(event_count) / elapsed : 0.0;
+        const double percent = 100.0 * static_cast<double>(event_count) / total_events_to_process;
+        const double remaining_time = (eps > 0.0)
+            ? (total_events_to_process - event_count) / eps
+            : 0.0;
+
+        std::cout << std::fixed
+                  << "[Progress] "
+                  << std::setw(6) << std::setprecision(1) << percent << "% "
+                  << "(" << std::setw(7) << event_count << "/" << total_events_to_process << ")"
+                  << " | Time: " << std::setw(7) << std::setprecision(2) << elapsed << " s"
+                  << " | Rate: " << std::setw(8) << std::setprecision(2) << eps << " events/s"
+                  << " | ETA: " << std::setw(7) << std::setprecision(2) << remaining_time << " s";
+        if (AllocationTracker::enabled()) {
+            std::cout << " | RSS: " << std::setw(8) << std::setprecision(1)
+                      << static_cast<double>(currentRssBytes()) / kBytesPerMiB << " MiB";
         }
+        std::cout << "\n";
 
-        tree.Fill();
-        profile->resetEventState();
-        dpm.clear();
-
-        if (event_count >= next_progress_event || event_count == total_events_to_process) {
-            const double elapsed = std::chrono::duration_cast<std::chrono::duration<double>>(
-                std::chrono::steady_clock::now() - t_start).count();
-            const double eps = (elapsed > 0.0) ? static_cast<double>(event_count) / elapsed : 0.0;
-            const double percent = 100.0 * static_cast<double>(event_count) / total_events_to_process;
-            const double remaining_time = (eps > 0.0)
-                ? (total_events_to_process - event_count) / eps
-                : 0.0;
-
-            std::cout << std::fixed
-                      << "[Progress] "
-                      << std::setw(6) << std::setprecision(1) << percent << "% "
-                      << "(" << std::setw(7) << event_count << "/" << total_events_to_process << ")"
-                      << " | Time: " << std::setw(7) << std::setprecision(2) << elapsed << " s"
-                      << " | Rate: " << std::setw(8) << std::setprecision(2) << eps << " events/s"
-                      << " | ETA: " << std::setw(7) << std::setprecision(2) << remaining_time << " s\n";
-
+        while (next_progress_event <= event_count) {
             next_progress_event += progress_step;
         }
+    };
+
+    const std::size_t event_count = runSessions(sessions, *reader, total_events_to_process, report_progress);
+    report_progress();
+    if (event_count < total_events_to_process) {
+        // A truncated read must not produce (or cache) outputs that look complete.
+        throw std::runtime_error("Input ended after " + std::to_string(event_count) + " of "
+                                 + std::to_string(total_events_to_process) + " events: " + input_path.string());
     }
 
     const auto t_end = std::chrono::steady_clock::now();
@@ -167,22 +503,58 @@ int UnpackerApp::run(const CLIOptions& options) const {
         ? static_cast<double>(event_count) / std::max(duration_sec, 1e-9)
         : 0.0;
 
-    output_file.cd();
-    tree.Write();
-    output_file.Close();
-    reader.reset();
+    {
+        ScopedRunPhase phase(RunPhase::Write);
+        for (auto& session : sessions) {
+            session->closeOutputs();
+        }
+        output_files.closeAll();
+        reader.reset();
+    }
 
     std::cout << "\n----------------------------------------\n";
     std::cout << "           Processing Summary\n";
     std::cout << "----------------------------------------\n";
-    std::cout << std::left << std::setw(25) << "Pipeline profile:" << profile->displayName() << "\n";
+    std::cout << std::left << std::setw(25) << (multi_profile ? "Pipeline profiles:" : "Pipeline profile:")
+              << sessionNames(sessions) << "\n";
     std::cout << std::left << std::setw(25) << "Events processed:" << std::right << std::setw(10)
               << event_count << "\n";
     std::cout << std::left << std::setw(25) << "Elapsed time (s):" << std::right << std::setw(10)
               << std::fixed << std::setprecision(2) << duration_sec << "\n";
     std::cout << std::left << std::setw(25) << "Events per second:" << std::right << std::setw(10)
               << std::fixed << std::setprecision(2) << rate << "\n";
-    std::cout << std::left << std::setw(25) << "Output written to:" << "output.root\n";
+    std::cout << std::left << std::setw(25) << "Peak RSS (MiB):" << std::right << std::setw(10)
+              << std::fixed << std::setprecision(2) << static_cast<double>(peakRssBytes()) / kBytesPerMiB << "\n";
+    if (AllocationTracker::enabled()) {
+        printAllocationReport(!multi_profile);
+    }
+    for (const auto& session : sessions) {
+        if (session->stageTimes()) {
+            printStageTimingReport(*session, session->eventsProcessed());
+        }
+    }
+    for (const auto& session : sessions) {
+        for (const auto& sink : session->sinks()) {
+            std::string label = "Output [" + sink->name() + "]:";
+            if (multi_profile) {
+                label = "Output [" + std::string(session->profile().primaryKey()) + "/" + sink->name() + "]:";
+            }
+            std::cout << std::left << std::setw(25) << label << std::right << std::setw(10)
+                      << sink->entries() << " entries -> " << sink->description() << "\n";
+        }
+    }
+
+    if (cache) {
+        const bool stored = cache->store(cache_key, output_paths);
+        const std::uintmax_t evicted = cache->evict(cache_key);
+        std::cout << std::left << std::setw(25) << "Cache entry:"
+                  << (stored ? "stored " : "not stored ") << cache_key;
+        if (evicted > 0) {
+            std::cout << " (evicted " << std::setprecision(2)
+                      << static_cast<double>(evicted) / static_cast<double>(kBytesPerGiB) << " GiB)";
+        }
+        std::cout << "\n";
+    }
     std::cout << "----------------------------------------\n";
 
     return EXIT_SUCCESS;
@@ -0,0 +1,93 @@
+#include "midas_file_unpacker_app/cache/CacheKeyBuilder.h"
+
+#include <TMD5.h>
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+namespace midas_file_unpacker_app {
+
+namespace {
+
+constexpr std::uintmax_t kIdentityChunkBytes = 1 << 20;
+
+void updateFromStream(TMD5& md5, std::ifstream& input, std::uintmax_t bytes) {
+    std::vector<char> buffer(64 * 1024);
+    while (bytes > 0 && input) {
+        const auto chunk = static_cast<std::streamsize>(std::min<std::uintmax_t>(bytes, buffer.size()));
+        input.read(buffer.data(), chunk);
+        const std::streamsize got = input.gcount();
+        if (got <= 0) {
+            break;
+        }
+        md5.Update(reinterpret_cast<const UChar_t*>(buffer.data()), static_cast<UInt_t>(got));
+        bytes -= static_cast<std::uintmax_t>(got);
+    }
+}
+
+std::ifstream openBinary(const std::filesystem::path& path) {
+    std::ifstream input(path, std::ios::binary);
+    if (!input) {
+        throw std::runtime_error("Cache: failed to read " + path.string());
+    }
+    return input;
+}
+
+} // namespace
+
+CacheKeyBuilder& CacheKeyBuilder::addString(std::string_view label, std::string_view value) {
+    material_.append(label).append("=").append(std::to_string(value.size())).append(":").append(value).append("\n");
+    return *this;
+}
+
+CacheKeyBuilder& CacheKeyBuilder::addFileContents(const std::filesystem::path& path) {
+    auto input = openBinary(path);
+    TMD5 md5;
+    updateFromStream(md5, input, std::filesystem::file_size(path));
+    md5.Final();
+    return addString("contents:" + path.filename().string(), md5.AsString());
+}
+
+CacheKeyBuilder& CacheKeyBuilder::addFileStamp(const std::filesystem::path& path) {
+    std::error_code ec;
+    const auto size = std::filesystem::file_size(path, ec);
+    if (ec) {
+        return addString("stamp:" + path.string(), "missing");
+    }
+    const auto mtime = std::filesystem::last_write_time(path, ec).time_since_epoch().count();
+
+    std::ostringstream oss;
+    oss << size << "@" << mtime;
+    return addString("stamp:" + path.string(), oss.str());
+}
+
+CacheKeyBuilder& CacheKeyBuilder::addInputIdentity(const std::filesystem::path& path) {
+    const std::uintmax_t size = std::filesystem::file_size(path);
+    auto input = openBinary(path);
+
+    TMD5 md5;
+    updateFromStream(md5, input, std::min(size, kIdentityChunkBytes));
+    if (size > kIdentityChunkBytes) {
+        const std::uintmax_t tail = std::min(size - kIdentityChunkBytes, kIdentityChunkBytes);
+        input.clear();
+        input.seekg(static_cast<std::streamoff>(size - tail));
+        updateFromStream(md5, input, tail);
+    }
+    md5.Final();
+
+    std::ostringstream oss;
+    oss << size << ":" << md5.AsString();
+    return addString("input", oss.str());
+}
+
+std::string CacheKeyBuilder::finish() const {
+    TMD5 md5;
+    md5.Update(reinterpret_cast<const UChar_t*>(material_.data()), static_cast<UInt_t>(material_.size()));
+    md5.Final();
+    return md5.AsString();
+}
+
+} // namespace midas_file_unpacker_app
@@ -0,0 +1,235 @@
+#include "midas_file_unpacker_app/cache/OutputCache.h"
+
+#include <nlohmann/json.hpp>
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+
+namespace midas_file_unpacker_app {
+
+namespace {
+
+namespace fs = std::filesystem;
+using json = nlohmann::json;
+
+constexpr const char* kManifestName = "manifest.json";
+constexpr const char* kStagingPrefix = ".staging-";
+constexpr auto kStaleStagingAge = std::chrono::hours(24);
+
+bool copyReplacing(const fs::path& from, const fs::path& to) {
+    std::error_code ec;
+    fs::copy_file(from, to, fs::copy_options::overwrite_existing, ec);
+    return !ec;
+}
+
+std::uintmax_t directorySize(const fs::path& dir) {
+    std::uintmax_t total = 0;
+    std::error_code ec;
+    for (fs::recursive_directory_iterator it(dir, ec), end; !ec && it != end; it.increment(ec)) {
+        std::error_code size_ec;
+        if (it->is_regular_file(size_ec)) {
+            const auto size = it->file_size(size_ec);
+            total += size_ec ? 0 : size;
+        }
+    }
+    return total;
+}
+
+bool startsWith(const std::string& value, const std::string& prefix) {
+    return value.compare(0, prefix.size(), prefix) == 0;
+}
+
+} // namespace
+
+OutputCache::OutputCache(fs::path directory, std::uintmax_t max_bytes)
+    : directory_(std::move(directory)),
+      max_bytes_(max_bytes) {
+    std::error_code ec;
+    fs::create_directories(directory_, ec);
+    if (ec || !fs::is_directory(directory_)) {
+        throw std::runtime_error("Cache directory is not usable: " + directory_.string());
+    }
+}
+
+fs::path OutputCache::entryPath(const std::string& key) const {
+    return directory_ / key;
+}
+
+void OutputCache::discard(const std::string& key) const {
+    // Rename first so no other process restores from a half-deleted entry.
+    const fs::path doomed = directory_ / (kStagingPrefix + key + "-discard-" + std::to_string(::getpid()));
+    std::error_code ec;
+    fs::rename(entryPath(key), doomed, ec);
+    if (!ec) {
+        fs::remove_all(doomed, ec);
+    }
+}
+
+bool OutputCache::restore(const std::string& key, const std::vector<std::string>& outputs) const {
+    const fs::path entry = entryPath(key);
+    std::ifstream input(entry / kManifestName);
+    if (!input) {
+        return false;
+    }
+
+    json manifest;
+    try {
+        input >> manifest;
+    } catch (const json::exception&) {
+        discard(key);
+        return false;
+    }
+
+    const json& files = manifest.value("outputs", json::array());
+    if (files.size() != outputs.size()) {
+        discard(key);
+        return false;
+    }
+
+    // Validate the whole entry before touching any destination file.
+    std::vector<fs::path> stored_paths;
+    for (std::size_t i = 0; i < outputs.size(); ++i) {
+        const fs::path stored = entry / files[i].value("stored", std::string());
+        std::error_code ec;
+        const auto size = fs::file_size(stored, ec);
+        if (ec || files[i].value("path", std::string()) != outputs[i]
+            || size != files[i].value("size", std::uintmax_t{0})) {
+            discard(key);
+            return false;
+        }
+        stored_paths.push_back(stored);
+    }
+
+    for (std::size_t i = 0; i < outputs.size(); ++i) {
+        const fs::path destination(outputs[i]);
+        const fs::path temporary = destination.string() + ".cache-restore";
+        std::error_code ec;
+        if (destination.has_parent_path()) {
+            fs::create_directories(destination.parent_path(), ec);
+        }
+        if (!copyReplacing(stored_paths[i], temporary)) {
+            return false;
+        }
+        fs::rename(temporary, destination, ec);
+        if (ec) {
+            fs::remove(temporary, ec);
+            return false;
+        }
+    }
+
+    std::error_code ec;
+    fs::last_write_time(entry / kManifestName, fs::file_time_type::clock::now(), ec);
+    return true;
+}
+
+bool OutputCache::store(const std::string& key, const std::vector<std::string>& outputs) const {
+    const fs::path entry = entryPath(key);
+    std::error_code ec;
+    if (fs::exists(entry / kManifestName, ec)) {
+        return true;
+    }
+
+    const fs::path staging = directory_ / (kStagingPrefix + key + "-" + std::to_string(::getpid()));
+    fs::remove_all(staging, ec);
+    if (!fs::create_directories(staging, ec)) {
+        return false;
+    }
+
+    json manifest;
+    manifest["key"] = key;
+    manifest["outputs"] = json::array();
+    for (std::size_t i = 0; i < outputs.size(); ++i) {
+        const std::string stored = std::to_string(i) + fs::path(outputs[i]).extension().string();
+        const auto size = fs::file_size(outputs[i], ec);
+        if (ec || !copyReplacing(outputs[i], staging / stored)) {
+            fs::remove_all(staging, ec);
+            return false;
+        }
+        manifest["outputs"].push_back({{"path", outputs[i]}, {"stored", stored}, {"size", size}});
+    }
+
+    {
+        std::ofstream output(staging / kManifestName);
+        output << manifest.dump(2) << "\n";
+        if (!output) {
+            fs::remove_all(staging, ec);
+            return false;
+        }
+    }
+
+    // Publishing is a single rename; if another process won the race its entry is equivalent.
+    fs::rename(staging, entry, ec);
+    if (ec) {
+        fs::remove_all(staging, ec);
+        return fs::exists(entry / kManifestName, ec);
+    }
+    return true;
+}
+
+std::uintmax_t OutputCache::evict(const std::string& keep_key) const {
+    struct Entry {
+        fs::path path;
+        fs::file_time_type last_used;
+        std::uintmax_t bytes = 0;
+    };
+
+    std::vector<Entry> entries;
+    std::uintmax_t total = 0;
+    const auto now = fs::file_time_type::clock::now();
+
+    std::error_code ec;
+    for (fs::directory_iterator it(directory_, ec), end; !ec && it != end; it.increment(ec)) {
+        std::error_code entry_ec;
+        if (!it->is_directory(entry_ec)) {
+            continue;
+        }
+
+        const std::string name = it->path().filename().string();
+        if (startsWith(name, kStagingPrefix)) {
+            // Leftovers from crashed runs; live staging directories are short-lived.
+            const auto modified = fs::last_write_time(it->path(), entry_ec);
+            if (!entry_ec && now - modified > kStaleStagingAge) {
+                fs::remove_all(it->path(), entry_ec);
+            }
+            continue;
+        }
+
+        Entry entry;
+        entry.path = it->path();
+        entry.bytes = directorySize(entry.path);
+        entry.last_used = fs::last_write_time(entry.path / kManifestName, entry_ec);
+        if (entry_ec) {
+            entry.last_used = fs::last_write_time(entry.path, entry_ec);
+        }
+        total += entry.bytes;
+        if (name != keep_key) {
+            entries.push_back(std::move(entry));
+        }
+    }
+
+    std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) {
+        return a.last_used < b.last_used;
+    });
+
+    std::uintmax_t freed = 0;
+    for (const auto& entry : entries) {
+        if (total <= max_bytes_) {
+            break;
+        }
+        std::error_code remove_ec;
+        fs::remove_all(entry.path, remove_ec);
+        if (!remove_ec) {
+            total -= entry.bytes;
+            freed += entry.bytes;
+        }
+    }
+    return freed;
+}
+
+} // namespace midas_file_unpacker_app
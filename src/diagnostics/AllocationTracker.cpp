@@ -0,0 +1,254 @@
+#include "midas_file_unpacker_app/diagnostics/AllocationTracker.h"
+
+// NOTE: This translation unit replaces the global operator new/delete for the whole
+// process (including ROOT and the pipeline plugins), so it must not allocate itself.
+
+#include <malloc.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <limits>
+#include <new>
+
+namespace midas_file_unpacker_app {
+
+namespace {
+
+struct PhaseCounters {
+    std::atomic<std::uint64_t> allocations{0};
+    std::atomic<std::uint64_t> allocated_bytes{0};
+    std::atomic<std::uint64_t> frees{0};
+    std::atomic<std::uint64_t> freed_bytes{0};
+    std::atomic<std::int64_t> live_bytes{0};
+    std::atomic<std::int64_t> peak_live_bytes{0};
+};
+
+// Every block carries this header just before the pointer handed out, so a free is charged
+// back to the phase that allocated the block. It keeps the default 16-byte alignment.
+struct BlockHeader {
+    void* base;
+    std::uint8_t phase;
+    bool tracked;
+};
+constexpr std::size_t kHeaderBytes = 16;
+static_assert(sizeof(BlockHeader) <= kHeaderBytes, "BlockHeader must fit in front of the block");
+constexpr std::uint8_t kNoPhaseOverride = 0xff;
+
+std::atomic<bool> g_enabled{false};
+std::atomic<std::uint8_t> g_phase{static_cast<std::uint8_t>(RunPhase::Setup)};
+thread_local std::uint8_t t_phase_override = kNoPhaseOverride;
+std::atomic<std::int64_t> g_live_bytes{0};
+std::atomic<std::int64_t> g_peak_live_bytes{0};
+PhaseCounters g_counters[kNumRunPhases];
+
+void raisePeak(std::atomic<std::int64_t>& peak, std::int64_t value) {
+    std::int64_t current = peak.load(std::memory_order_relaxed);
+    while (value > current && !peak.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+    }
+}
+
+std::uint8_t currentPhase() {
+    return t_phase_override != kNoPhaseOverride ? t_phase_override : g_phase.load(std::memory_order_relaxed);
+}
+
+BlockHeader* headerOf(void* ptr) {
+    return reinterpret_cast<BlockHeader*>(static_cast<char*>(ptr) - kHeaderBytes);
+}
+
+std::int64_t blockBytes(const BlockHeader& header, void* ptr) {
+    return static_cast<std::int64_t>(::malloc_usable_size(header.base))
+        - (static_cast<char*>(ptr) - static_cast<char*>(header.base));
+}
+
+/// Writes the header in front of `ptr` (inside the block starting at `base`) and counts it.
+void* recordAllocation(void* base, void* ptr) {
+    BlockHeader* header = headerOf(ptr);
+    header->base = base;
+    header->tracked = g_enabled.load(std::memory_order_relaxed);
+    header->phase = currentPhase();
+    if (!header->tracked) {
+        return ptr;
+    }
+
+    const std::int64_t bytes = blockBytes(*header, ptr);
+    PhaseCounters& counters = g_counters[header->phase];
+    counters.allocations.fetch_add(1, std::memory_order_relaxed);
+    counters.allocated_bytes.fetch_add(static_cast<std::uint64_t>(bytes), std::memory_order_relaxed);
+    raisePeak(counters.peak_live_bytes,
+              counters.live_bytes.fetch_add(bytes, std::memory_order_relaxed) + bytes);
+    raisePeak(g_peak_live_bytes, g_live_bytes.fetch_add(bytes, std::memory_order_relaxed) + bytes);
+    return ptr;
+}
+
+/// Returns the underlying allocation to hand to free().
+void* recordFree(void* ptr) {
+    const BlockHeader* header = headerOf(ptr);
+    if (header->tracked) {
+        const std::int64_t bytes = blockBytes(*header, ptr);
+        PhaseCounters& counters = g_counters[header->phase];
+        counters.frees.fetch_add(1, std::memory_order_relaxed);
+        counters.freed_bytes.fetch_add(static_cast<std::uint64_t>(bytes), std::memory_order_relaxed);
+        counters.live_bytes.fetch_sub(bytes, std::memory_order_relaxed);
+        g_live_bytes.fetch_sub(bytes, std::memory_order_relaxed);
+    }
+    return header->base;
+}
+
+void* allocate(std::size_t size) {
+    if (size > std::numeric_limits<std::size_t>::max() - kHeaderBytes) {
+        throw std::bad_alloc();
+    }
+    for (;;) {
+        if (void* base = std::malloc(size + kHeaderBytes)) {
+            return recordAllocation(base, static_cast<char*>(base) + kHeaderBytes);
+        }
+        std::new_handler handler = std::get_new_handler();
+        if (!handler) {
+            throw std::bad_alloc();
+        }
+        handler();
+    }
+}
+
+void* allocateAligned(std::size_t size, std::align_val_t alignment) {
+    // The header takes a whole alignment unit so the returned pointer stays aligned.
+    const std::size_t align = std::max(static_cast<std::size_t>(alignment), kHeaderBytes);
+    if (size > std::numeric_limits<std::size_t>::max() - 2 * align) {
+        throw std::bad_alloc();
+    }
+    // aligned_alloc requires the size to be a multiple of the alignment.
+    const std::size_t total = (size + align + align - 1) / align * align;
+    for (;;) {
+        if (void* base = std::aligned_alloc(align, total)) {
+            return recordAllocation(base, static_cast<char*>(base) + align);
+        }
+        std::new_handler handler = std::get_new_handler();
+        if (!handler) {
+            throw std::bad_alloc();
+        }
+        handler();
+    }
+}
+
+void deallocate(void* ptr) noexcept {
+    if (ptr) {
+        std::free(recordFree(ptr));
+    }
+}
+
+} // namespace
+
+const char* runPhaseName(RunPhase phase) {
+    switch (phase) {
+    case RunPhase::Setup: return "setup";
+    case RunPhase::Count: return "count";
+    case RunPhase::Read: return "read";
+    case RunPhase::Input: return "input";
+    case RunPhase::Pipeline: return "pipeline";
+    case RunPhase::Extract: return "extract";
+    case RunPhase::Fill: return "fill";
+    case RunPhase::Clear: return "clear";
+    case RunPhase::Write: return "write";
+    case RunPhase::NumPhases: break;
+    }
+    return "unknown";
+}
+
+void AllocationTracker::enable() {
+    g_enabled.store(true, std::memory_order_relaxed);
+}
+
+bool AllocationTracker::enabled() {
+    return g_enabled.load(std::memory_order_relaxed);
+}
+
+RunPhase AllocationTracker::setPhase(RunPhase phase) {
+    return static_cast<RunPhase>(g_phase.exchange(static_cast<std::uint8_t>(phase), std::memory_order_relaxed));
+}
+
+std::optional<RunPhase> AllocationTracker::setThreadPhase(std::optional<RunPhase> phase) {
+    const std::uint8_t previous = t_phase_override;
+    t_phase_override = phase ? static_cast<std::uint8_t>(*phase) : kNoPhaseOverride;
+    if (previous == kNoPhaseOverride) {
+        return std::nullopt;
+    }
+    return static_cast<RunPhase>(previous);
+}
+
+std::array<PhaseAllocationStats, kNumRunPhases> AllocationTracker::snapshot() {
+    std::array<PhaseAllocationStats, kNumRunPhases> stats;
+    for (std::size_t i = 0; i < kNumRunPhases; ++i) {
+        stats[i].allocations = g_counters[i].allocations.load(std::memory_order_relaxed);
+        stats[i].allocated_bytes = g_counters[i].allocated_bytes.load(std::memory_order_relaxed);
+        stats[i].frees = g_counters[i].frees.load(std::memory_order_relaxed);
+        stats[i].freed_bytes = g_counters[i].freed_bytes.load(std::memory_order_relaxed);
+        stats[i].live_bytes = g_counters[i].live_bytes.load(std::memory_order_relaxed);
+        stats[i].peak_live_bytes = g_counters[i].peak_live_bytes.load(std::memory_order_relaxed);
+    }
+    return stats;
+}
+
+std::int64_t AllocationTracker::liveBytes() {
+    return g_live_bytes.load(std::memory_order_relaxed);
+}
+
+std::int64_t AllocationTracker::peakLiveBytes() {
+    return g_peak_live_bytes.load(std::memory_order_relaxed);
+}
+
+} // namespace midas_file_unpacker_app
+
+using midas_file_unpacker_app::allocate;
+using midas_file_unpacker_app::allocateAligned;
+using midas_file_unpacker_app::deallocate;
+
+void* operator new(std::size_t size) { return allocate(size); }
+void* operator new[](std::size_t size) { return allocate(size); }
+void* operator new(std::size_t size, std::align_val_t alignment) { return allocateAligned(size, alignment); }
+void* operator new[](std::size_t size, std::align_val_t alignment) { return allocateAligned(size, alignment); }
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    try {
+        return allocate(size);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    try {
+        return allocate(size);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    try {
+        return allocateAligned(size, alignment);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    try {
+        return allocateAligned(size, alignment);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void operator delete(void* ptr) noexcept { deallocate(ptr); }
+void operator delete[](void* ptr) noexcept { deallocate(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { deallocate(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { deallocate(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { deallocate(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { deallocate(ptr); }
+void operator delete(void* ptr, std::align_val_t) noexcept { deallocate(ptr); }
+void operator delete[](void* ptr, std::align_val_t) noexcept { deallocate(ptr); }
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept { deallocate(ptr); }
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept { deallocate(ptr); }
+void operator delete(void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { deallocate(ptr); }
+void operator delete[](void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { deallocate(ptr); }
@@ -0,0 +1,46 @@
+#include "midas_file_unpacker_app/io/BatchQueue.h"
+
+#include <stdexcept>
+#include <utility>
+
+namespace midas_file_unpacker_app {
+
+BatchQueue::BatchQueue(std::size_t capacity)
+    : capacity_(capacity) {
+    if (capacity_ == 0) {
+        throw std::invalid_argument("BatchQueue capacity must be positive");
+    }
+}
+
+void BatchQueue::push(std::shared_ptr<const EventBatch> batch) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    not_full_.wait(lock, [this] { return closed_ || batches_.size() < capacity_; });
+    if (closed_) {
+        throw std::runtime_error("BatchQueue::push after close");
+    }
+    batches_.push_back(std::move(batch));
+    not_empty_.notify_one();
+}
+
+std::shared_ptr<const EventBatch> BatchQueue::pop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    not_empty_.wait(lock, [this] { return closed_ || !batches_.empty(); });
+    if (batches_.empty()) {
+        return nullptr;
+    }
+    auto batch = std::move(batches_.front());
+    batches_.pop_front();
+    not_full_.notify_one();
+    return batch;
+}
+
+void BatchQueue::close() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        closed_ = true;
+    }
+    not_empty_.notify_all();
+    not_full_.notify_all();
+}
+
+} // namespace midas_file_unpacker_app
@@ -0,0 +1,35 @@
+#include "midas_file_unpacker_app/io/EventBatch.h"
+
+#include "midasio.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace midas_file_unpacker_app {
+
+EventBatch::EventBatch(std::size_t capacity)
+    : capacity_(capacity) {
+    if (capacity_ == 0) {
+        throw std::invalid_argument("EventBatch capacity must be positive");
+    }
+    events_.reserve(capacity_);
+}
+
+std::size_t EventBatch::read(TMReaderInterface& reader, std::size_t limit) {
+    events_.clear();
+    const std::size_t wanted = std::min(capacity_, limit);
+    while (events_.size() < wanted) {
+        TMEvent* raw_event = TMReadEvent(&reader);
+        if (!raw_event) {
+            break;
+        }
+        events_.emplace_back(raw_event);
+    }
+    // TMReadEvent returns nullptr both at end of input and on a read error.
+    if (reader.fError) {
+        throw std::runtime_error("Failed to read MIDAS event: " + reader.fErrorString);
+    }
+    return events_.size();
+}
+
+} // namespace midas_file_unpacker_app
@@ -0,0 +1,29 @@
+#include "midas_file_unpacker_app/io/MidasReader.h"
+
+#include "midas_file_unpacker_app/io/SeekableMidasFile.h"
+#include "midas_file_unpacker_app/io/SeekableMidasReader.h"
+
+#include "midasio.h"
+
+namespace midas_file_unpacker_app {
+
+void ReaderDeleter::operator()(TMReaderInterface* reader) const {
+    delete reader;
+}
+
+ReaderPtr openMidasReader(const std::filesystem::path& path) {
+    if (SeekableMidasFile::isSeekable(path)) {
+        auto file = std::make_shared<const SeekableMidasFile>(path);
+        return ReaderPtr(new SeekableMidasReader(std::move(file)));
+    }
+    return ReaderPtr(TMNewReader(path.string().c_str()));
+}
+
+std::optional<std::size_t> indexedEventCount(const std::filesystem::path& path) {
+    if (!SeekableMidasFile::isSeekable(path)) {
+        return std::nullopt;
+    }
+    return static_cast<std::size_t>(SeekableMidasFile(path).eventCount());
+}
+
+} // namespace midas_file_unpacker_app
@@ -0,0 +1,206 @@
+#include "midas_file_unpacker_app/io/SeekableMidasFile.h"
+
+#include <RZip.h>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+namespace midas_file_unpacker_app {
+
+namespace {
+
+constexpr std::size_t kRootBlockHeaderBytes = 9;
+
+} // namespace
+
+bool SeekableMidasFile::isSeekable(const std::filesystem::path& path) {
+    std::ifstream input(path, std::ios::binary);
+    char magic[sizeof(kSeekableHeaderMagic)] = {};
+    if (!input.read(magic, sizeof(magic))) {
+        return false;
+    }
+    return std::memcmp(magic, kSeekableHeaderMagic, sizeof(magic)) == 0;
+}
+
+SeekableMidasFile::SeekableMidasFile(const std::filesystem::path& path)
+    : path_(path) {
+    fd_ = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd_ < 0) {
+        throw std::runtime_error("Failed to open seekable MIDAS file: " + path.string());
+    }
+
+    struct stat info {};
+    if (::fstat(fd_, &info) != 0) {
+        ::close(fd_);
+        throw std::runtime_error("Failed to stat seekable MIDAS file: " + path.string());
+    }
+    const auto file_size = static_cast<std::uint64_t>(info.st_size);
+
+    try {
+        if (file_size < sizeof(header_) + sizeof(footer_)) {
+            throw std::runtime_error("file is too small");
+        }
+
+        readAt(&header_, sizeof(header_), 0);
+        if (std::memcmp(header_.magic, kSeekableHeaderMagic, sizeof(header_.magic)) != 0) {
+            throw std::runtime_error("bad header magic");
+        }
+        if (header_.byte_order != kSeekableByteOrderMark) {
+            throw std::runtime_error("written on a host with a different byte order");
+        }
+        if (header_.version != kSeekableFormatVersion) {
+            throw std::runtime_error("unsupported format version " + std::to_string(header_.version));
+        }
+
+        readAt(&footer_, sizeof(footer_), file_size - sizeof(footer_));
+        if (std::memcmp(footer_.magic, kSeekableFooterMagic, sizeof(footer_.magic)) != 0) {
+            throw std::runtime_error("missing footer (file truncated or still being written)");
+        }
+        if (footer_.frame_count > file_size / sizeof(SeekableFrameIndexEntry)
+            || footer_.index_offset < sizeof(header_)
+            || footer_.index_offset + footer_.frame_count * sizeof(SeekableFrameIndexEntry) + sizeof(footer_)
+                   != file_size) {
+            throw std::runtime_error("frame index does not match the file size");
+        }
+
+        frames_.resize(footer_.frame_count);
+        readAt(frames_.data(), frames_.size() * sizeof(SeekableFrameIndexEntry), footer_.index_offset);
+        validateIndex();
+    } catch (const std::exception& ex) {
+        ::close(fd_);
+        throw std::runtime_error("Invalid seekable MIDAS file " + path.string() + ": " + ex.what());
+    }
+}
+
+void SeekableMidasFile::validateIndex() const {
+    if (header_.frame_target_bytes == 0 || header_.frame_target_bytes > kSeekableMaxFrameBytes) {
+        throw std::runtime_error("implausible frame size " + std::to_string(header_.frame_target_bytes));
+    }
+
+    std::uint64_t next_event = 0;
+    std::uint64_t raw_total = 0;
+    for (std::size_t i = 0; i < frames_.size(); ++i) {
+        const SeekableFrameIndexEntry& entry = frames_[i];
+        // The writer only exceeds the target size for a frame holding one large event.
+        const std::uint64_t max_raw_bytes = entry.event_count == 1
+            ? std::max<std::uint64_t>(header_.frame_target_bytes, kSeekableMaxEventBytes)
+            : header_.frame_target_bytes;
+        const bool corrupt = entry.offset < sizeof(header_)
+            || entry.offset > footer_.index_offset
+            || entry.compressed_bytes > footer_.index_offset - entry.offset
+            || entry.compressed_bytes > entry.raw_bytes
+            || entry.event_count == 0
+            || entry.raw_bytes > max_raw_bytes
+            || entry.first_event != next_event;
+        if (corrupt) {
+            throw std::runtime_error("corrupt index entry for frame " + std::to_string(i));
+        }
+        next_event += entry.event_count;
+        raw_total += entry.raw_bytes;
+    }
+    if (next_event != footer_.event_count || raw_total != footer_.raw_bytes) {
+        throw std::runtime_error("frame index totals do not match the footer");
+    }
+}
+
+SeekableMidasFile::~SeekableMidasFile() {
+    if (fd_ >= 0) {
+        ::close(fd_);
+    }
+}
+
+void SeekableMidasFile::readAt(void* buffer, std::size_t size, std::uint64_t offset) const {
+    auto* out = static_cast<char*>(buffer);
+    while (size > 0) {
+        const ssize_t got = ::pread(fd_, out, size, static_cast<off_t>(offset));
+        if (got < 0 && errno == EINTR) {
+            continue;
+        }
+        if (got <= 0) {
+            throw std::runtime_error("short read from " + path_.string());
+        }
+        out += got;
+        size -= static_cast<std::size_t>(got);
+        offset += static_cast<std::uint64_t>(got);
+    }
+}
+
+std::vector<char> SeekableMidasFile::readFrame(std::size_t index) const {
+    const SeekableFrameIndexEntry& entry = frames_.at(index);
+
+    std::vector<char> stored(entry.compressed_bytes);
+    readAt(stored.data(), stored.size(), entry.offset);
+    if (entry.compressed_bytes == entry.raw_bytes) {
+        return stored;
+    }
+
+    // Check the block headers against the index before allocating the output buffer.
+    std::uint64_t declared_raw = 0;
+    for (std::size_t pos = 0; pos < stored.size();) {
+        auto* src = reinterpret_cast<unsigned char*>(stored.data() + pos);
+        int block_size = 0;
+        int block_raw_size = 0;
+        if (stored.size() - pos < kRootBlockHeaderBytes
+            || R__unzip_header(&block_size, src, &block_raw_size) != 0
+            || block_size <= 0
+            || static_cast<std::size_t>(block_size) > stored.size() - pos) {
+            std::ostringstream oss;
+            oss << "Corrupt frame " << index << " in " << path_.string();
+            throw std::runtime_error(oss.str());
+        }
+        declared_raw += static_cast<std::uint64_t>(block_raw_size);
+        pos += static_cast<std::size_t>(block_size);
+    }
+    if (declared_raw != entry.raw_bytes) {
+        std::ostringstream oss;
+        oss << "Frame " << index << " in " << path_.string() << " declares " << declared_raw
+            << " raw bytes, index says " << entry.raw_bytes;
+        throw std::runtime_error(oss.str());
+    }
+
+    std::vector<char> raw(entry.raw_bytes);
+    std::size_t in_pos = 0;
+    std::size_t out_pos = 0;
+    while (in_pos < stored.size()) {
+        auto* src = reinterpret_cast<unsigned char*>(stored.data() + in_pos);
+        int block_size = 0;
+        int block_raw_size = 0;
+        if (stored.size() - in_pos < kRootBlockHeaderBytes
+            || R__unzip_header(&block_size, src, &block_raw_size) != 0
+            || static_cast<std::size_t>(block_size) > stored.size() - in_pos
+            || static_cast<std::size_t>(block_raw_size) > raw.size() - out_pos) {
+            std::ostringstream oss;
+            oss << "Corrupt frame " << index << " in " << path_.string();
+            throw std::runtime_error(oss.str());
+        }
+
+        int produced = 0;
+        R__unzip(&block_size, src, &block_raw_size,
+                 reinterpret_cast<unsigned char*>(raw.data() + out_pos), &produced);
+        if (produced != block_raw_size) {
+            std::ostringstream oss;
+            oss << "Failed to decompress frame " << index << " in " << path_.string();
+            throw std::runtime_error(oss.str());
+        }
+        in_pos += static_cast<std::size_t>(block_size);
+        out_pos += static_cast<std::size_t>(produced);
+    }
+
+    if (out_pos != raw.size()) {
+        std::ostringstream oss;
+        oss << "Frame " << index << " in " << path_.string() << " decompressed to " << out_pos
+            << " bytes, expected " << raw.size();
+        throw std::runtime_error(oss.str());
+    }
+    return raw;
+}
+
+} // namespace midas_file_unpacker_app
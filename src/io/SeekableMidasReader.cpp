@@ -0,0 +1,87 @@
+#include "midas_file_unpacker_app/io/SeekableMidasReader.h"
+
+#include "midas_file_unpacker_app/diagnostics/AllocationTracker.h"
+#include "midas_file_unpacker_app/io/SeekableMidasFile.h"
+
+#include <algorithm>
+#include <cstring>
+#include <exception>
+#include <utility>
+
+namespace midas_file_unpacker_app {
+
+SeekableMidasReader::SeekableMidasReader(std::shared_ptr<const SeekableMidasFile> file,
+                                         std::size_t first_frame,
+                                         std::size_t end_frame)
+    : file_(std::move(file)),
+      next_frame_(first_frame),
+      end_frame_(std::min(end_frame, file_->frames().size())) {
+    startPrefetch();
+}
+
+SeekableMidasReader::SeekableMidasReader(std::shared_ptr<const SeekableMidasFile> file)
+    : SeekableMidasReader(file, 0, file->frames().size()) {}
+
+SeekableMidasReader::~SeekableMidasReader() {
+    Close();
+}
+
+void SeekableMidasReader::startPrefetch() {
+    if (next_frame_ >= end_frame_) {
+        return;
+    }
+    const std::size_t frame = next_frame_++;
+    prefetch_ = std::async(std::launch::async, [file = file_, frame]() {
+        // Runs while the caller is in another phase; the frame buffers belong to Read.
+        ScopedThreadRunPhase phase(RunPhase::Read);
+        return file->readFrame(frame);
+    });
+}
+
+bool SeekableMidasReader::advanceFrame() {
+    if (!prefetch_.valid()) {
+        return false;
+    }
+    current_ = prefetch_.get();
+    position_ = 0;
+    startPrefetch();
+    return true;
+}
+
+int SeekableMidasReader::Read(void* buf, int count) {
+    auto* out = static_cast<char*>(buf);
+    int total = 0;
+    while (total < count) {
+        if (position_ >= current_.size()) {
+            try {
+                if (!advanceFrame()) {
+                    break;
+                }
+            } catch (const std::exception& ex) {
+                fError = true;
+                fErrorString = ex.what();
+                return -1;
+            }
+            continue;
+        }
+
+        const std::size_t chunk = std::min(static_cast<std::size_t>(count - total), current_.size() - position_);
+        std::memcpy(out + total, current_.data() + position_, chunk);
+        position_ += chunk;
+        total += static_cast<int>(chunk);
+    }
+    return total;
+}
+
+int SeekableMidasReader::Close() {
+    if (prefetch_.valid()) {
+        prefetch_.wait();
+        prefetch_ = std::future<std::vector<char>>();
+    }
+    next_frame_ = end_frame_;
+    current_.clear();
+    position_ = 0;
+    return 0;
+}
+
+} // namespace midas_file_unpacker_app
@@ -0,0 +1,154 @@
+#include "midas_file_unpacker_app/io/SeekableMidasWriter.h"
+
+#include <RZip.h>
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <system_error>
+
+namespace midas_file_unpacker_app {
+
+SeekableMidasWriter::SeekableMidasWriter(const std::filesystem::path& path,
+                                         std::size_t frame_bytes,
+                                         int compression_settings)
+    : path_(path),
+      output_(path, std::ios::binary | std::ios::trunc),
+      frame_bytes_(frame_bytes),
+      compression_settings_(compression_settings) {
+    if (!output_) {
+        throw std::runtime_error("Failed to create seekable MIDAS file: " + path.string());
+    }
+    if (frame_bytes_ == 0 || frame_bytes_ > kSeekableMaxFrameBytes) {
+        output_.close();
+        std::error_code ec;
+        std::filesystem::remove(path_, ec);
+        throw std::invalid_argument("Seekable MIDAS frame size must be between 1 byte and 1 GiB");
+    }
+
+    SeekableFileHeader header{};
+    std::memcpy(header.magic, kSeekableHeaderMagic, sizeof(header.magic));
+    header.version = kSeekableFormatVersion;
+    header.byte_order = kSeekableByteOrderMark;
+    header.frame_target_bytes = frame_bytes_;
+    header.compression_settings = compression_settings_;
+    writeBytes(&header, sizeof(header));
+
+    pending_.reserve(frame_bytes_);
+}
+
+SeekableMidasWriter::~SeekableMidasWriter() {
+    // Only close() produces a valid container; anything left unclosed is a failed run.
+    if (!closed_) {
+        discard();
+    }
+}
+
+void SeekableMidasWriter::discard() noexcept {
+    closed_ = true;
+    output_.close();
+    std::error_code ec;
+    std::filesystem::remove(path_, ec);
+}
+
+void SeekableMidasWriter::writeEvent(const char* data, std::size_t size) {
+    if (closed_) {
+        throw std::logic_error("SeekableMidasWriter::writeEvent called after close()");
+    }
+
+    if (!pending_.empty() && pending_.size() + size > frame_bytes_) {
+        flushFrame();
+    }
+    pending_.insert(pending_.end(), data, data + size);
+    ++pending_events_;
+    ++event_count_;
+    raw_bytes_ += size;
+
+    if (pending_.size() >= frame_bytes_) {
+        flushFrame();
+    }
+}
+
+void SeekableMidasWriter::flushFrame() {
+    if (pending_events_ == 0) {
+        return;
+    }
+
+    SeekableFrameIndexEntry entry{};
+    entry.offset = offset_;
+    entry.raw_bytes = pending_.size();
+    entry.first_event = event_count_ - pending_events_;
+    entry.event_count = pending_events_;
+
+    const auto algorithm = static_cast<ROOT::RCompressionSetting::EAlgorithm::EValues>(compression_settings_ / 100);
+    const int level = compression_settings_ % 100;
+
+    // Only keep the compressed form if every block shrank; otherwise store the frame raw.
+    compressed_.resize(pending_.size());
+    std::size_t in_pos = 0;
+    std::size_t out_pos = 0;
+    bool compressed = level > 0;
+    while (compressed && in_pos < pending_.size()) {
+        int src_size = static_cast<int>(std::min(pending_.size() - in_pos, kSeekableMaxBlockBytes));
+        int tgt_size = static_cast<int>(std::min(compressed_.size() - out_pos, kSeekableMaxBlockBytes));
+        int written = 0;
+        R__zipMultipleAlgorithm(level, &src_size, pending_.data() + in_pos,
+                                &tgt_size, compressed_.data() + out_pos, &written, algorithm);
+        if (written <= 0) {
+            compressed = false;
+            break;
+        }
+        in_pos += static_cast<std::size_t>(src_size);
+        out_pos += static_cast<std::size_t>(written);
+    }
+
+    if (compressed && out_pos < pending_.size()) {
+        entry.compressed_bytes = out_pos;
+        writeBytes(compressed_.data(), out_pos);
+    } else {
+        entry.compressed_bytes = pending_.size();
+        writeBytes(pending_.data(), pending_.size());
+    }
+
+    index_.push_back(entry);
+    pending_.clear();
+    pending_events_ = 0;
+}
+
+void SeekableMidasWriter::writeBytes(const void* data, std::size_t size) {
+    output_.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+    if (!output_) {
+        throw std::runtime_error("Failed to write seekable MIDAS file: " + path_.string());
+    }
+    offset_ += size;
+}
+
+void SeekableMidasWriter::close() {
+    if (closed_) {
+        return;
+    }
+    try {
+        flushFrame();
+
+        SeekableFileFooter footer{};
+        footer.index_offset = offset_;
+        footer.frame_count = index_.size();
+        footer.event_count = event_count_;
+        footer.raw_bytes = raw_bytes_;
+        std::memcpy(footer.magic, kSeekableFooterMagic, sizeof(footer.magic));
+
+        writeBytes(index_.data(), index_.size() * sizeof(SeekableFrameIndexEntry));
+        writeBytes(&footer, sizeof(footer));
+
+        output_.close();
+        if (!output_) {
+            throw std::runtime_error("Failed to finalize seekable MIDAS file: " + path_.string());
+        }
+    } catch (...) {
+        discard();
+        throw;
+    }
+    closed_ = true;
+}
+
+} // namespace midas_file_unpacker_app
@@ -0,0 +1,62 @@
+#include "midas_file_unpacker_app/outputs/HistogramOutputSink.h"
+
+#include "midas_file_unpacker_app/outputs/OutputFileRegistry.h"
+#include "midas_file_unpacker_app/profiles/EventSummary.h"
+#include "midas_file_unpacker_app/profiles/PipelineProfile.h"
+
+#include <TDirectory.h>
+#include <TFile.h>
+#include <TH1D.h>
+
+#include <stdexcept>
+#include <utility>
+
+namespace midas_file_unpacker_app {
+
+HistogramOutputSink::HistogramOutputSink(OutputSinkConfig config)
+    : OutputSink(std::move(config)) {}
+
+void HistogramOutputSink::openOutput(PipelineProfile& profile, OutputFileRegistry& files) {
+    TFile& file = files.open(config_.file, config_.compression_settings);
+    directory_ = file.mkdir(config_.object_name.c_str(), "", true);
+    if (!directory_) {
+        throw std::runtime_error("Output '" + config_.name + "': failed to create directory '"
+                                 + config_.object_name + "' in " + config_.file);
+    }
+    directory_->cd();
+
+    const std::string label = std::string(profile.displayName());
+    const double max_hits = static_cast<double>(config_.histogram_max_hits);
+    hit_count_ = new TH1D("hit_count", (label + " hits per event;hits;events").c_str(),
+                          static_cast<int>(config_.histogram_max_hits) + 1, -0.5, max_hits + 0.5);
+    channel_occupancy_ = new TH1D("channel_occupancy", (label + " hits per channel;channel;hits").c_str(),
+                                  static_cast<int>(EventSummary::kMaxChannels), -0.5,
+                                  static_cast<double>(EventSummary::kMaxChannels) - 0.5);
+    hit_count_->SetDirectory(directory_);
+    channel_occupancy_->SetDirectory(directory_);
+}
+
+void HistogramOutputSink::fillEvent(const EventSummary& summary) {
+    hit_count_->Fill(static_cast<double>(summary.hit_count));
+    for (std::size_t channel = 0; channel < EventSummary::kMaxChannels; ++channel) {
+        if (summary.channel_hits[channel] > 0) {
+            channel_occupancy_->Fill(static_cast<double>(channel), static_cast<double>(summary.channel_hits[channel]));
+        }
+    }
+}
+
+void HistogramOutputSink::close() {
+    if (!directory_) {
+        return;
+    }
+    directory_->cd();
+    hit_count_->Write("", TObject::kOverwrite);
+    channel_occupancy_->Write("", TObject::kOverwrite);
+    directory_ = nullptr;
+}
+
+std::string HistogramOutputSink::description() const {
+    return config_.file + ":" + config_.object_name + "/";
+}
+
+} // namespace midas_file_unpacker_app
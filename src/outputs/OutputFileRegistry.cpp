@@ -0,0 +1,62 @@
+#include "midas_file_unpacker_app/outputs/OutputFileRegistry.h"
+
+#include <TFile.h>
+
+#include <filesystem>
+#include <stdexcept>
+
+namespace midas_file_unpacker_app {
+
+OutputFileRegistry::OutputFileRegistry() = default;
+
+OutputFileRegistry::~OutputFileRegistry() {
+    closeAll();
+}
+
+OutputFileRegistry::Entry* OutputFileRegistry::find(const std::string& path) {
+    const std::string key = std::filesystem::path(path).lexically_normal().string();
+    for (auto& entry : files_) {
+        if (entry.path == key) {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+TFile& OutputFileRegistry::open(const std::string& path, const std::optional<int>& compression_settings) {
+    if (Entry* entry = find(path)) {
+        return *entry->file;
+    }
+
+    const std::string key = std::filesystem::path(path).lexically_normal().string();
+
+    auto file = std::make_unique<TFile>(key.c_str(), "RECREATE");
+    if (file->IsZombie()) {
+        throw std::runtime_error("Failed to create output file: " + key);
+    }
+    if (compression_settings) {
+        file->SetCompressionSettings(*compression_settings);
+    }
+
+    files_.push_back(Entry{key, std::move(file), std::make_unique<std::mutex>()});
+    return *files_.back().file;
+}
+
+std::mutex& OutputFileRegistry::fileMutex(const std::string& path) {
+    Entry* entry = find(path);
+    if (!entry) {
+        throw std::runtime_error("Output file is not open: " + path);
+    }
+    return *entry->mutex;
+}
+
+void OutputFileRegistry::closeAll() {
+    for (auto& entry : files_) {
+        if (entry.file) {
+            entry.file->Close();
+        }
+    }
+    files_.clear();
+}
+
+} // namespace midas_file_unpacker_app
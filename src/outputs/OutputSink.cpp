@@ -0,0 +1,53 @@
+#include "midas_file_unpacker_app/outputs/OutputSink.h"
+
+#include "midas_file_unpacker_app/outputs/HistogramOutputSink.h"
+#include "midas_file_unpacker_app/outputs/OutputFileRegistry.h"
+#include "midas_file_unpacker_app/outputs/SummaryOutputSink.h"
+#include "midas_file_unpacker_app/outputs/TreeOutputSink.h"
+
+#include <utility>
+
+namespace midas_file_unpacker_app {
+
+OutputSink::OutputSink(OutputSinkConfig config)
+    : config_(std::move(config)) {}
+
+void OutputSink::link(const std::vector<std::unique_ptr<OutputSink>>&) {}
+
+void OutputSink::open(PipelineProfile& profile, OutputFileRegistry& files) {
+    openOutput(profile, files);
+    file_mutex_ = &files.fileMutex(config_.file);
+}
+
+void OutputSink::fill(const EventSummary& summary) {
+    std::unique_lock<std::mutex> lock;
+    if (file_mutex_) {
+        lock = std::unique_lock<std::mutex>(*file_mutex_);
+    }
+    fillEvent(summary);
+    ++entries_;
+}
+
+std::vector<std::unique_ptr<OutputSink>> createOutputSinks(const std::vector<OutputSinkConfig>& configs) {
+    std::vector<std::unique_ptr<OutputSink>> sinks;
+    sinks.reserve(configs.size());
+    for (const auto& config : configs) {
+        switch (config.type) {
+        case OutputSinkType::Tree:
+            sinks.push_back(std::make_unique<TreeOutputSink>(config));
+            break;
+        case OutputSinkType::Histograms:
+            sinks.push_back(std::make_unique<HistogramOutputSink>(config));
+            break;
+        case OutputSinkType::Summary:
+            sinks.push_back(std::make_unique<SummaryOutputSink>(config));
+            break;
+        }
+    }
+    for (auto& sink : sinks) {
+        sink->link(sinks);
+    }
+    return sinks;
+}
+
+} // namespace midas_file_unpacker_app
@@ -0,0 +1,234 @@
+#include "midas_file_unpacker_app/outputs/OutputSinkConfig.h"
+
+#include "midas_file_unpacker_app/profiles/EventSummary.h"
+#include "midas_file_unpacker_app/profiles/PipelineProfile.h"
+
+#include <Compression.h>
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace midas_file_unpacker_app {
+
+namespace {
+
+using json = nlohmann::json;
+
+std::string toLowerCopy(std::string value) {
+    std::transform(value.begin(), value.end(), value.begin(), [](unsigned char c) {
+        return static_cast<char>(std::tolower(c));
+    });
+    return value;
+}
+
+[[noreturn]] void throwConfigError(const std::string& sink, const std::string& message) {
+    std::ostringstream oss;
+    oss << "Output '" << sink << "': " << message;
+    throw std::runtime_error(oss.str());
+}
+
+OutputSinkType parseType(const std::string& sink, const std::string& value) {
+    const std::string type = toLowerCopy(value);
+    if (type == "tree") {
+        return OutputSinkType::Tree;
+    }
+    if (type == "histograms") {
+        return OutputSinkType::Histograms;
+    }
+    if (type == "summary") {
+        return OutputSinkType::Summary;
+    }
+    throwConfigError(sink, "unknown type '" + value + "' (expected 'tree', 'histograms' or 'summary')");
+}
+
+int parseCompression(const std::string& sink, const json& node) {
+    using Algorithm = ROOT::RCompressionSetting::EAlgorithm;
+
+    const std::string name = toLowerCopy(node.value("algorithm", std::string("zlib")));
+    Algorithm::EValues algorithm = Algorithm::kZLIB;
+    if (name == "zlib") {
+        algorithm = Algorithm::kZLIB;
+    } else if (name == "lzma") {
+        algorithm = Algorithm::kLZMA;
+    } else if (name == "lz4") {
+        algorithm = Algorithm::kLZ4;
+    } else if (name == "zstd") {
+        algorithm = Algorithm::kZSTD;
+    } else {
+        throwConfigError(sink, "unknown compression algorithm '" + name + "'");
+    }
+
+    const int level = node.value("level", 1);
+    if (level < 0 || level > 9) {
+        throwConfigError(sink, "compression level must be between 0 and 9");
+    }
+    return ROOT::CompressionSettings(algorithm, level);
+}
+
+EventSelection parseSelection(const std::string& sink, const json& node) {
+    EventSelection selection;
+    if (node.contains("min_hits")) {
+        selection.min_hits = node.at("min_hits").get<std::uint32_t>();
+    }
+    if (node.contains("max_hits")) {
+        selection.max_hits = node.at("max_hits").get<std::uint32_t>();
+    }
+    if (node.contains("channels")) {
+        for (const auto& channel_node : node.at("channels")) {
+            const long channel = channel_node.get<long>();
+            if (channel < 0 || static_cast<std::size_t>(channel) >= EventSummary::kMaxChannels) {
+                std::ostringstream oss;
+                oss << "selection channel " << channel << " is outside [0, "
+                    << EventSummary::kMaxChannels << ")";
+                throwConfigError(sink, oss.str());
+            }
+            selection.any_channel_mask |= (std::uint64_t{1} << channel);
+        }
+    }
+    return selection;
+}
+
+OutputSinkConfig parseSink(const json& node, std::size_t index) {
+    OutputSinkConfig config;
+    config.name = node.value("name", "output" + std::to_string(index));
+    config.type = parseType(config.name, node.value("type", std::string("tree")));
+    config.file = node.value("file", config.file);
+
+    if (config.type == OutputSinkType::Tree) {
+        config.object_name = node.value("tree_name", std::string("events"));
+    } else if (config.type == OutputSinkType::Summary) {
+        config.object_name = node.value("tree_name", std::string("summary"));
+        config.events_output = node.value("events_output", std::string());
+    } else {
+        config.object_name = node.value("directory", config.name);
+        config.histogram_max_hits = node.value("max_hits", config.histogram_max_hits);
+        if (config.histogram_max_hits == 0) {
+            throwConfigError(config.name, "max_hits must be positive");
+        }
+    }
+
+    if (node.contains("branches")) {
+        if (config.type != OutputSinkType::Tree) {
+            throwConfigError(config.name, "'branches' is only valid for tree outputs");
+        }
+        config.branches = node.at("branches").get<std::vector<std::string>>();
+        if (config.branches.empty()) {
+            throwConfigError(config.name, "'branches' must not be empty (omit it to keep all branches)");
+        }
+    }
+    if (node.contains("selection")) {
+        config.selection = parseSelection(config.name, node.at("selection"));
+    }
+    if (node.contains("compression")) {
+        config.compression_settings = parseCompression(config.name, node.at("compression"));
+    }
+
+    return config;
+}
+
+} // namespace
+
+bool EventSelection::accepts(const EventSummary& summary) const {
+    if (min_hits && summary.hit_count < *min_hits) {
+        return false;
+    }
+    if (max_hits && summary.hit_count > *max_hits) {
+        return false;
+    }
+    if (any_channel_mask != 0 && (summary.channel_mask & any_channel_mask) == 0) {
+        return false;
+    }
+    return true;
+}
+
+std::vector<OutputSinkConfig> loadOutputSinkConfigs(const std::filesystem::path& path) {
+    std::ifstream input(path);
+    if (!input) {
+        throw std::runtime_error("Failed to open outputs config: " + path.string());
+    }
+
+    json root;
+    try {
+        input >> root;
+    } catch (const json::exception& ex) {
+        throw std::runtime_error("Failed to parse outputs config " + path.string() + ": " + ex.what());
+    }
+
+    if (!root.contains("outputs") || !root.at("outputs").is_array() || root.at("outputs").empty()) {
+        throw std::runtime_error("Outputs config must contain a non-empty 'outputs' array: " + path.string());
+    }
+
+    std::vector<OutputSinkConfig> configs;
+    std::unordered_set<std::string> names;
+    std::unordered_set<std::string> objects;
+    std::unordered_set<std::string> tree_outputs;
+    // The first output opening a file decides its file-level compression.
+    std::unordered_map<std::string, std::size_t> file_owners;
+    std::size_t index = 0;
+    for (const auto& node : root.at("outputs")) {
+        try {
+            configs.push_back(parseSink(node, index++));
+        } catch (const json::exception& ex) {
+            throw std::runtime_error("Invalid entry in outputs config " + path.string() + ": " + ex.what());
+        }
+
+        auto& config = configs.back();
+        config.file = std::filesystem::path(config.file).lexically_normal().string();
+        if (!names.insert(config.name).second) {
+            throwConfigError(config.name, "duplicate output name");
+        }
+        if (!objects.insert(config.file + ":" + config.object_name).second) {
+            throwConfigError(config.name, "'" + config.object_name + "' is already written to " + config.file);
+        }
+        // Trees and summaries set compression per branch; histograms inherit the file's.
+        const auto& owner = configs[file_owners.emplace(config.file, configs.size() - 1).first->second];
+        if (config.type == OutputSinkType::Histograms && config.compression_settings
+            && config.compression_settings != owner.compression_settings) {
+            throwConfigError(config.name, "histograms use the compression of " + config.file
+                                          + ", which is set by output '" + owner.name + "'");
+        }
+        if (config.type == OutputSinkType::Tree) {
+            tree_outputs.insert(config.name);
+        }
+    }
+
+    for (auto& config : configs) {
+        if (config.type != OutputSinkType::Summary) {
+            continue;
+        }
+        if (config.events_output.empty()) {
+            const auto first_tree = std::find_if(configs.begin(), configs.end(), [](const OutputSinkConfig& other) {
+                return other.type == OutputSinkType::Tree;
+            });
+            if (first_tree != configs.end()) {
+                config.events_output = first_tree->name;
+            }
+        } else if (tree_outputs.count(config.events_output) == 0) {
+            throwConfigError(config.name, "events_output '" + config.events_output + "' is not a tree output");
+        }
+    }
+
+    return configs;
+}
+
+void checkOutputBranches(const std::vector<OutputSinkConfig>& configs, const PipelineProfile& profile) {
+    const auto available = profile.branchNames();
+    for (const auto& config : configs) {
+        for (const auto& branch : config.branches) {
+            if (std::find(available.begin(), available.end(), branch) == available.end()) {
+                throwConfigError(config.name, "profile " + std::string(profile.displayName())
+                                              + " has no branch '" + branch + "'");
+            }
+        }
+    }
+}
+
+} // namespace midas_file_unpacker_app
@@ -0,0 +1,95 @@
+#include "midas_file_unpacker_app/outputs/SummaryOutputSink.h"
+
+#include "midas_file_unpacker_app/outputs/OutputFileRegistry.h"
+#include "midas_file_unpacker_app/profiles/PipelineProfile.h"
+
+#include <TBranch.h>
+#include <TFile.h>
+#include <TObjArray.h>
+#include <TTree.h>
+
+#include <utility>
+
+namespace midas_file_unpacker_app {
+
+SummaryOutputSink::SummaryOutputSink(OutputSinkConfig config)
+    : OutputSink(std::move(config)) {}
+
+void SummaryOutputSink::link(const std::vector<std::unique_ptr<OutputSink>>& sinks) {
+    // Sinks are filled in config order; remember whether the events tree has already
+    // counted the current event when this sink runs.
+    bool seen_self = false;
+    for (const auto& sink : sinks) {
+        if (sink.get() == this) {
+            seen_self = true;
+        } else if (!config_.events_output.empty() && sink->name() == config_.events_output) {
+            events_sink_ = sink.get();
+            events_sink_fills_first_ = !seen_self;
+        }
+    }
+}
+
+void SummaryOutputSink::openOutput(PipelineProfile& profile, OutputFileRegistry& files) {
+    file_ = &files.open(config_.file, config_.compression_settings);
+    file_->cd();
+
+    const std::string tree_title = std::string(profile.displayName()) + " per-event summary";
+    tree_ = new TTree(config_.object_name.c_str(), tree_title.c_str());
+    tree_->SetDirectory(file_);
+
+    const std::string channel_leaf = "channel_hits[" + std::to_string(EventSummary::kMaxChannels) + "]/i";
+    tree_->Branch("entry", &entry_, "entry/L");
+    tree_->Branch("midas_serial", &record_.midas_serial, "midas_serial/i");
+    tree_->Branch("midas_time", &record_.midas_time, "midas_time/i");
+    tree_->Branch("midas_event_id", &record_.midas_event_id, "midas_event_id/s");
+    tree_->Branch("midas_bytes", &record_.midas_bytes, "midas_bytes/i");
+    tree_->Branch("midas_banks", &record_.midas_banks, "midas_banks/i");
+    tree_->Branch("bank_entries", &record_.bank_entries, "bank_entries/i");
+    tree_->Branch("bank_names", record_.bank_names.data(), "bank_names[bank_entries]/i");
+    tree_->Branch("bank_bytes", record_.bank_bytes.data(), "bank_bytes[bank_entries]/i");
+    tree_->Branch("detector_time", &record_.detector_time, "detector_time/D");
+    tree_->Branch("hit_count", &record_.hit_count, "hit_count/i");
+    tree_->Branch("channel_mask", &record_.channel_mask, "channel_mask/l");
+    tree_->Branch("channel_hits", record_.channel_hits.data(), channel_leaf.c_str());
+
+    if (config_.compression_settings) {
+        TObjArray* branches = tree_->GetListOfBranches();
+        for (int i = 0; branches && i < branches->GetEntriesFast(); ++i) {
+            static_cast<TBranch*>(branches->UncheckedAt(i))->SetCompressionSettings(*config_.compression_settings);
+        }
+    }
+}
+
+void SummaryOutputSink::fillEvent(const EventSummary& summary) {
+    record_ = summary;
+    entry_ = -1;
+    if (events_sink_ && events_sink_->accepts(summary)) {
+        const auto filled = static_cast<long long>(events_sink_->entries());
+        entry_ = events_sink_fills_first_ ? filled - 1 : filled;
+    }
+    tree_->Fill();
+}
+
+void SummaryOutputSink::close() {
+    if (!tree_) {
+        return;
+    }
+    file_->cd();
+    // The summary tree is small, so indexing it after the fill loop is cheap. The index
+    // sorts by MIDAS time with the serial number as tie-breaker.
+    if (tree_->GetEntries() > 0) {
+        tree_->BuildIndex("midas_time", "midas_serial");
+    }
+    tree_->Write("", TObject::kOverwrite);
+    tree_ = nullptr;
+}
+
+std::string SummaryOutputSink::description() const {
+    std::string text = config_.file + ":" + config_.object_name;
+    if (events_sink_) {
+        text += " (entry -> " + events_sink_->description() + ")";
+    }
+    return text;
+}
+
+} // namespace midas_file_unpacker_app
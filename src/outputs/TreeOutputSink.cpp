@@ -0,0 +1,53 @@
+#include "midas_file_unpacker_app/outputs/TreeOutputSink.h"
+
+#include "midas_file_unpacker_app/outputs/OutputFileRegistry.h"
+#include "midas_file_unpacker_app/profiles/PipelineProfile.h"
+
+#include <TBranch.h>
+#include <TFile.h>
+#include <TObjArray.h>
+#include <TTree.h>
+
+#include <utility>
+
+namespace midas_file_unpacker_app {
+
+TreeOutputSink::TreeOutputSink(OutputSinkConfig config)
+    : OutputSink(std::move(config)) {}
+
+void TreeOutputSink::openOutput(PipelineProfile& profile, OutputFileRegistry& files) {
+    file_ = &files.open(config_.file, config_.compression_settings);
+    file_->cd();
+
+    const std::string tree_title = std::string(profile.displayName()) + " unpacked events";
+    tree_ = new TTree(config_.object_name.c_str(), tree_title.c_str());
+    tree_->SetDirectory(file_);
+    profile.setupTree(*tree_, config_.branches);
+
+    // Branch-level settings let several trees in one file use different compression.
+    if (config_.compression_settings) {
+        TObjArray* branches = tree_->GetListOfBranches();
+        for (int i = 0; branches && i < branches->GetEntriesFast(); ++i) {
+            static_cast<TBranch*>(branches->UncheckedAt(i))->SetCompressionSettings(*config_.compression_settings);
+        }
+    }
+}
+
+void TreeOutputSink::fillEvent(const EventSummary&) {
+    tree_->Fill();
+}
+
+void TreeOutputSink::close() {
+    if (!tree_) {
+        return;
+    }
+    file_->cd();
+    tree_->Write("", TObject::kOverwrite);
+    tree_ = nullptr;
+}
+
+std::string TreeOutputSink::description() const {
+    return config_.file + ":" + config_.object_name;
+}
+
+} // namespace midas_file_unpacker_app
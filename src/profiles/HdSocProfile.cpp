@@ -2,6 +2,8 @@
 
 // NOTE: Separate translation unit for HDSoC profile to keep class-per-file structure.
 
+#include "midas_file_unpacker_app/profiles/EventSummary.h"
+
 #include <TTree.h>
 
 #include "analysis_pipeline/core/data/pipeline_data_product_manager.h"
@@ -13,16 +15,26 @@ namespace midas_file_unpacker_app {
 HdSocProfile::HdSocProfile()
     : primary_key_("hdsoc"),
       display_name_("HDSoC"),
-      config_relative_path_("config/unpacker_pipelines/HDSoC/default_unpacking_pipeline.json") {}
+      config_relative_path_("config/unpacker_pipelines/HDSoC/default_unpacking_pipeline.json"),
+      outputs_config_relative_path_("config/unpacker_outputs/HDSoC/default_outputs.json") {}
 
 std::string_view HdSocProfile::primaryKey() const { return primary_key_; }
 std::string_view HdSocProfile::displayName() const { return display_name_; }
 std::filesystem::path HdSocProfile::configRelativePath() const { return config_relative_path_; }
+std::filesystem::path HdSocProfile::outputsConfigRelativePath() const { return outputs_config_relative_path_; }
 PipelineMode HdSocProfile::mode() const { return PipelineMode::HdSoc; }
 
-void HdSocProfile::setupTree(TTree& tree) {
-    tree.Branch("nalu_event", &event_ptr_);
-    tree.Branch("nalu_time", &time_ptr_);
+std::vector<std::string> HdSocProfile::branchNames() const {
+    return {"nalu_event", "nalu_time"};
+}
+
+void HdSocProfile::setupTree(TTree& tree, const std::vector<std::string>& branches) {
+    if (branchRequested(branches, "nalu_event")) {
+        tree.Branch("nalu_event", &event_ptr_);
+    }
+    if (branchRequested(branches, "nalu_time")) {
+        tree.Branch("nalu_time", &time_ptr_);
+    }
 }
 
 bool HdSocProfile::extractEvent(PipelineDataProductManager& dpm) {
@@ -52,6 +64,22 @@ bool HdSocProfile::extractEvent(PipelineDataProductManager& dpm) {
     return true;
 }
 
+void HdSocProfile::summarizeEvent(EventSummary& summary) const {
+    summary.reset();
+    if (!event_ptr_) {
+        return;
+    }
+
+    // Each Nalu packet is one channel readout window, so packets stand in for hits.
+    for (const auto& packet : event_ptr_->packets.packets) {
+        summary.addHit(static_cast<long>(packet.channel));
+    }
+
+    if (time_ptr_) {
+        summary.detector_time = static_cast<double>(time_ptr_->time.event_time);
+    }
+}
+
 void HdSocProfile::resetEventState() {
     event_lock_ = PipelineDataProductReadLock();
     time_lock_ = PipelineDataProductReadLock();
@@ -3,6 +3,8 @@
 // NOTE: Implementation extracted from the previous monolithic Profiles.cpp
 // to keep a single class per file for easier future maintenance.
 
+#include "midas_file_unpacker_app/profiles/EventSummary.h"
+
 #include <TTree.h>
 
 #include "analysis_pipeline/core/data/pipeline_data_product_manager.h"
@@ -15,18 +17,32 @@ namespace midas_file_unpacker_app {
 SampicProfile::SampicProfile()
     : primary_key_("sampic"),
       display_name_("SAMPIC"),
-      config_relative_path_("config/unpacker_pipelines/SAMPIC/default_unpacking_pipeline.json") {}
+      config_relative_path_("config/unpacker_pipelines/SAMPIC/default_unpacking_pipeline.json"),
+      outputs_config_relative_path_("config/unpacker_outputs/SAMPIC/default_outputs.json") {}
 
 std::string_view SampicProfile::primaryKey() const { return primary_key_; }
 std::string_view SampicProfile::displayName() const { return display_name_; }
 std::filesystem::path SampicProfile::configRelativePath() const { return config_relative_path_; }
+std::filesystem::path SampicProfile::outputsConfigRelativePath() const { return outputs_config_relative_path_; }
 PipelineMode SampicProfile::mode() const { return PipelineMode::Sampic; }
 
-void SampicProfile::setupTree(TTree& tree) {
-    tree.Branch("sampic_event", &event_ptr_);
-    tree.Branch("sampic_event_timing", &event_timing_ptr_);
-    tree.Branch("sampic_collector_timing", &collector_timing_ptr_);
-    tree.Branch("has_sampic_collector_timing", &has_collector_flag_, "has_sampic_collector_timing/O");
+std::vector<std::string> SampicProfile::branchNames() const {
+    return {"sampic_event", "sampic_event_timing", "sampic_collector_timing", "has_sampic_collector_timing"};
+}
+
+void SampicProfile::setupTree(TTree& tree, const std::vector<std::string>& branches) {
+    if (branchRequested(branches, "sampic_event")) {
+        tree.Branch("sampic_event", &event_ptr_);
+    }
+    if (branchRequested(branches, "sampic_event_timing")) {
+        tree.Branch("sampic_event_timing", &event_timing_ptr_);
+    }
+    if (branchRequested(branches, "sampic_collector_timing")) {
+        tree.Branch("sampic_collector_timing", &collector_timing_ptr_);
+    }
+    if (branchRequested(branches, "has_sampic_collector_timing")) {
+        tree.Branch("has_sampic_collector_timing", &has_collector_flag_, "has_sampic_collector_timing/O");
+    }
 }
 
 bool SampicProfile::extractEvent(PipelineDataProductManager& dpm) {
@@ -64,6 +80,23 @@ bool SampicProfile::extractEvent(PipelineDataProductManager& dpm) {
     return true;
 }
 
+void SampicProfile::summarizeEvent(EventSummary& summary) const {
+    summary.reset();
+    if (!event_ptr_) {
+        return;
+    }
+
+    bool have_time = false;
+    for (const auto& hit : event_ptr_->hits) {
+        summary.addHit(static_cast<long>(hit.channel));
+        const double timestamp = static_cast<double>(hit.first_cell_timestamp);
+        if (!have_time || timestamp < summary.detector_time) {
+            summary.detector_time = timestamp;
+            have_time = true;
+        }
+    }
+}
+
 void SampicProfile::resetEventState() {
     event_lock_ = PipelineDataProductReadLock();
     event_timing_lock_ = PipelineDataProductReadLock();
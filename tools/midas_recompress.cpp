@@ -0,0 +1,202 @@
+// midas-recompress: converts a MIDAS run (.mid, .mid.lz4, .mid.gz, ...) into the seekable
+// frame container read by the unpacker (see io/SeekableMidasFormat.h).
+
+#include "midas_file_unpacker_app/io/SeekableMidasFormat.h"
+#include "midas_file_unpacker_app/io/SeekableMidasWriter.h"
+
+#include <Compression.h>
+
+#include "midasio.h"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+using namespace midas_file_unpacker_app;
+
+namespace {
+
+struct RecompressOptions {
+    std::string input;
+    std::string output;
+    std::size_t frame_mib = kSeekableDefaultFrameBytes / (1024 * 1024);
+    std::string algorithm = "zstd";
+    int level = 5;
+    bool show_help = false;
+};
+
+void printUsage(const char* program) {
+    std::cout << "Usage: " << program << " [OPTIONS] <input_midas_file> [output_file]\n\n"
+              << "Options:\n"
+              << "  --frame-size <MiB>   Uncompressed bytes per frame (default 4)\n"
+              << "  --algorithm <name>   zstd (default), lz4, zlib or lzma\n"
+              << "  --level <0-9>        Compression level (default 5, 0 stores frames raw)\n"
+              << "  --help               Show this help message\n\n"
+              << "The output defaults to the input name without its compression suffix plus '.skz'.\n";
+}
+
+int parseInt(const std::string& value, int min, int max) {
+    std::size_t pos = 0;
+    int parsed = 0;
+    try {
+        parsed = std::stoi(value, &pos);
+    } catch (const std::exception&) {
+        pos = 0;
+    }
+    if (pos != value.size() || parsed < min || parsed > max) {
+        throw std::runtime_error("Invalid value '" + value + "' (expected " + std::to_string(min)
+                                 + "-" + std::to_string(max) + ")");
+    }
+    return parsed;
+}
+
+RecompressOptions parseArguments(int argc, char** argv) {
+    RecompressOptions options;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        auto next = [&]() -> std::string {
+            if (i + 1 >= argc) {
+                throw std::runtime_error(arg + " requires a value");
+            }
+            return argv[++i];
+        };
+
+        if (arg == "-h" || arg == "--help") {
+            options.show_help = true;
+            return options;
+        } else if (arg == "--frame-size") {
+            options.frame_mib = static_cast<std::size_t>(parseInt(next(), 1, 1024));
+        } else if (arg == "--algorithm") {
+            options.algorithm = next();
+            std::transform(options.algorithm.begin(), options.algorithm.end(), options.algorithm.begin(),
+                           [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        } else if (arg == "--level") {
+            options.level = parseInt(next(), 0, 9);
+        } else if (!arg.empty() && arg.front() == '-') {
+            throw std::runtime_error("Unknown option '" + arg + "'");
+        } else if (options.input.empty()) {
+            options.input = arg;
+        } else if (options.output.empty()) {
+            options.output = arg;
+        } else {
+            throw std::runtime_error("Unexpected argument '" + arg + "'");
+        }
+    }
+
+    if (options.input.empty()) {
+        throw std::runtime_error("Missing required <input_midas_file> argument");
+    }
+    if (options.output.empty()) {
+        std::filesystem::path output(options.input);
+        const std::string extension = output.extension().string();
+        if (extension == ".lz4" || extension == ".gz" || extension == ".bz2") {
+            output.replace_extension();
+        }
+        options.output = output.string() + ".skz";
+    }
+    return options;
+}
+
+int compressionSettings(const RecompressOptions& options) {
+    using Algorithm = ROOT::RCompressionSetting::EAlgorithm;
+    Algorithm::EValues algorithm = Algorithm::kZSTD;
+    if (options.algorithm == "zstd") {
+        algorithm = Algorithm::kZSTD;
+    } else if (options.algorithm == "lz4") {
+        algorithm = Algorithm::kLZ4;
+    } else if (options.algorithm == "zlib") {
+        algorithm = Algorithm::kZLIB;
+    } else if (options.algorithm == "lzma") {
+        algorithm = Algorithm::kLZMA;
+    } else {
+        throw std::runtime_error("Unknown compression algorithm '" + options.algorithm + "'");
+    }
+    return ROOT::CompressionSettings(algorithm, options.level);
+}
+
+int recompress(const RecompressOptions& options) {
+    if (!std::filesystem::exists(options.input)) {
+        throw std::runtime_error("Input file does not exist: " + options.input);
+    }
+    std::error_code ec;
+    if (std::filesystem::equivalent(options.input, options.output, ec)) {
+        throw std::runtime_error("Output would overwrite the input file");
+    }
+
+    std::unique_ptr<TMReaderInterface> reader(TMNewReader(options.input.c_str()));
+    if (!reader) {
+        throw std::runtime_error("Failed to open MIDAS file: " + options.input);
+    }
+
+    // Write to a temporary name so an interrupted conversion never looks complete. On any
+    // error the writer is destroyed unclosed and deletes the partial file.
+    const std::string partial = options.output + ".partial";
+    SeekableMidasWriter writer(partial, options.frame_mib * 1024 * 1024, compressionSettings(options));
+
+    const auto t_start = std::chrono::steady_clock::now();
+    while (TMEvent* raw_event = TMReadEvent(reader.get())) {
+        std::unique_ptr<TMEvent> event(raw_event);
+        writer.writeEvent(event->data.data(), event->data.size());
+    }
+    if (reader->fError) {
+        throw std::runtime_error("Error reading " + options.input + ": " + reader->fErrorString);
+    }
+    reader->Close();
+    writer.close();
+    std::filesystem::rename(partial, options.output, ec);
+    if (ec) {
+        std::filesystem::remove(partial, ec);
+        throw std::runtime_error("Failed to move " + partial + " to " + options.output);
+    }
+
+    const double elapsed = std::chrono::duration_cast<std::chrono::duration<double>>(
+        std::chrono::steady_clock::now() - t_start).count();
+    const auto input_bytes = std::filesystem::file_size(options.input);
+    const auto output_bytes = std::filesystem::file_size(options.output);
+
+    std::cout << std::left << std::setw(25) << "Output written to:" << options.output << "\n";
+    std::cout << std::left << std::setw(25) << "Events:" << std::right << std::setw(14) << writer.eventCount() << "\n";
+    std::cout << std::left << std::setw(25) << "Frames:" << std::right << std::setw(14) << writer.frameCount() << "\n";
+    std::cout << std::left << std::setw(25) << "Uncompressed bytes:" << std::right << std::setw(14) << writer.rawBytes() << "\n";
+    std::cout << std::left << std::setw(25) << "Input file bytes:" << std::right << std::setw(14) << input_bytes << "\n";
+    std::cout << std::left << std::setw(25) << "Output file bytes:" << std::right << std::setw(14) << output_bytes
+              << " (" << std::fixed << std::setprecision(3)
+              << static_cast<double>(output_bytes) / static_cast<double>(std::max<std::uintmax_t>(input_bytes, 1))
+              << "x input)\n";
+    std::cout << std::left << std::setw(25) << "Elapsed time (s):" << std::right << std::setw(14)
+              << std::fixed << std::setprecision(2) << elapsed << "\n";
+    return EXIT_SUCCESS;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    RecompressOptions options;
+    try {
+        options = parseArguments(argc, argv);
+    } catch (const std::exception& ex) {
+        std::cerr << "Error: " << ex.what() << "\n\n";
+        printUsage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    if (options.show_help) {
+        printUsage(argv[0]);
+        return EXIT_SUCCESS;
+    }
+
+    try {
+        return recompress(options);
+    } catch (const std::exception& ex) {
+        std::cerr << "Fatal error: " << ex.what() << '\n';
+        return EXIT_FAILURE;
+    }
+}